@@ -0,0 +1,69 @@
+#include "../include/graph.hpp"
+#include "../include/mapping.hpp"
+#include "../include/mcsplit.hpp"
+#include "../include/rng.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+using namespace mcs;
+
+/**
+ * @brief Escalamiento del solver exacto (McSplit) con 1, 2, 4, ..., 64 hilos.
+ *
+ * Resuelve el mismo par de gráficas aleatorias G(n, p) con cada número de
+ * hilos y reporta tiempo, nodos y aceleración respecto a un hilo.
+ *
+ * Uso: exact_speedup [n] [p] [semilla] [hilos máximos]
+ */
+
+static Graph random_graph(std::size_t n, double p, Rng& rng) {
+    const auto threshold = static_cast<std::uint64_t>(p * static_cast<double>(Rng::max()));
+    std::vector<std::pair<Vertex, Vertex>> edges;
+    for (std::size_t u = 0; u < n; ++u) {
+        for (std::size_t v = u + 1; v < n; ++v) {
+            if (rng() <= threshold) {
+                edges.emplace_back(static_cast<Vertex>(u), static_cast<Vertex>(v));
+            }
+        }
+    }
+    return Graph(n, edges, GraphStorage::Dense);
+}
+
+int main(int argc, char* argv[]) {
+    const std::size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 24;
+    const double p = argc > 2 ? std::atof(argv[2]) : 0.5;
+    const std::uint64_t seed = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 1;
+    const int max_threads = argc > 4 ? std::atoi(argv[4]) : 64;
+
+    Rng rng(seed);
+    const Graph g1 = random_graph(n, p, rng);
+    const Graph g2 = random_graph(n, p, rng);
+
+    std::cout << "McSplit: G(" << n << ", " << p << "), semilla " << seed << "\n";
+    std::cout << "  hilos  tiempo (s)         nodos   tamaño  aceleración\n";
+
+    double base = 0.0;
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        McSplit solver(g1, g2);
+        solver.set_threads(threads);
+
+        const auto start = std::chrono::steady_clock::now();
+        const Mapping best = solver.solve();
+        const std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+
+        if (threads == 1) base = elapsed.count();
+
+        std::cout << std::setw(7) << threads
+                  << std::setw(12) << std::fixed << std::setprecision(3) << elapsed.count()
+                  << std::setw(14) << solver.nodes()
+                  << std::setw(9) << best.size()
+                  << std::setw(12) << std::setprecision(2) << base / elapsed.count()
+                  << "x\n";
+    }
+    return 0;
+}
@@ -0,0 +1,418 @@
+#include "../include/aco.hpp"
+#include "../include/ant.hpp"
+#include "../include/graph.hpp"
+#include "../include/graph_cache.hpp"
+#include "../include/mapping.hpp"
+#include "../include/pheromone.hpp"
+#include "../include/reader.hpp"
+#include "../include/rng.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifndef MCS_VERSION
+#define MCS_VERSION "desconocida"
+#endif
+
+using namespace mcs;
+
+/**
+ * @brief Microbenchmarks de las rutas críticas sobre familias de instancias
+ * generadas con semillas fijas.
+ *
+ * Familias: Erdős–Rényi G(n, p) con varias densidades, pares isomorfos (g2 es
+ * una permutación de g1) y libres de escala (Barabási–Albert). Para cada una
+ * se mide Mapping::is_feasible_add, Ant::construct_solution (que recorre
+ * select_next_pair y compute_heuristic), PheromoneMatrix::evaporate (perezosa
+ * e inmediata), Reader::read_graph (texto y caché .mcsg) y ACO::solve
+ * completo con un hilo.
+ *
+ * Cada medición calibra un lote que dure al menos --min-time segundos y lo
+ * repite --repetitions veces; se reporta ns por operación (mediana, mínimo y
+ * máximo). Con --json los resultados se guardan para comparar versiones.
+ *
+ * Uso: mcs_bench [--json archivo] [--filter texto] [--min-time s]
+ *                [--repetitions n]
+ */
+
+struct Options {
+    std::string json_path;
+    std::string filter;
+    double min_time = 0.05;
+    int repetitions = 5;
+};
+
+struct Result {
+    std::string name;
+    std::string family;
+    std::size_t n1;
+    std::size_t n2;
+    long long batch;
+    int repetitions;
+    double median_ns;
+    double min_ns;
+    double max_ns;
+};
+
+struct Family {
+    std::string name;
+    Graph g1;
+    Graph g2;
+};
+
+// Evita que el compilador elimine un resultado que no se usa
+template <class T>
+static inline void keep(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+// ============================================================================
+// GENERADORES
+// ============================================================================
+
+using EdgeList = std::vector<std::pair<Vertex, Vertex>>;
+
+static EdgeList erdos_renyi(std::size_t n, double p, Rng& rng) {
+    const auto threshold = static_cast<std::uint64_t>(p * static_cast<double>(Rng::max()));
+    EdgeList edges;
+    for (std::size_t u = 0; u < n; ++u) {
+        for (std::size_t v = u + 1; v < n; ++v) {
+            if (rng() <= threshold) {
+                edges.emplace_back(static_cast<Vertex>(u), static_cast<Vertex>(v));
+            }
+        }
+    }
+    return edges;
+}
+
+// Barabási–Albert: cada vértice nuevo se une a m vértices elegidos con
+// probabilidad proporcional al grado (muestreo sobre la lista de extremos)
+static EdgeList scale_free(std::size_t n, std::size_t m, Rng& rng) {
+    EdgeList edges;
+    std::vector<Vertex> endpoints;
+    for (std::size_t u = 0; u <= m; ++u) {
+        for (std::size_t v = u + 1; v <= m; ++v) {
+            edges.emplace_back(static_cast<Vertex>(u), static_cast<Vertex>(v));
+            endpoints.push_back(static_cast<Vertex>(u));
+            endpoints.push_back(static_cast<Vertex>(v));
+        }
+    }
+    std::vector<Vertex> chosen;
+    for (std::size_t u = m + 1; u < n; ++u) {
+        chosen.clear();
+        while (chosen.size() < m) {
+            const Vertex v = endpoints[rng() % endpoints.size()];
+            if (std::find(chosen.begin(), chosen.end(), v) == chosen.end()) chosen.push_back(v);
+        }
+        for (Vertex v : chosen) {
+            edges.emplace_back(static_cast<Vertex>(u), v);
+            endpoints.push_back(static_cast<Vertex>(u));
+            endpoints.push_back(v);
+        }
+    }
+    return edges;
+}
+
+static EdgeList permuted(const EdgeList& edges, std::size_t n, Rng& rng) {
+    std::vector<Vertex> perm(n);
+    std::iota(perm.begin(), perm.end(), 0);
+    for (std::size_t i = n; i > 1; --i) std::swap(perm[i - 1], perm[rng() % i]);
+    EdgeList out;
+    out.reserve(edges.size());
+    for (const auto& [u, v] : edges) out.emplace_back(perm[u], perm[v]);
+    return out;
+}
+
+static std::vector<Family> make_families() {
+    std::vector<Family> families;
+    const std::size_t n = 200;
+
+    for (double p : {0.1, 0.5, 0.9}) {
+        Rng rng(1000 + static_cast<std::uint64_t>(p * 100));
+        const EdgeList e1 = erdos_renyi(n, p, rng);
+        const EdgeList e2 = erdos_renyi(n, p, rng);
+        char name[32];
+        std::snprintf(name, sizeof name, "er-%zu-%.1f", n, p);
+        families.push_back({name, Graph(n, e1), Graph(n, e2)});
+    }
+
+    {
+        Rng rng(2000);
+        const EdgeList e1 = erdos_renyi(n, 0.3, rng);
+        const EdgeList e2 = permuted(e1, n, rng);
+        families.push_back({"iso-200-0.3", Graph(n, e1), Graph(n, e2)});
+    }
+
+    {
+        const std::size_t big = 1000;
+        Rng rng(3000);
+        const EdgeList e1 = scale_free(big, 3, rng);
+        const EdgeList e2 = scale_free(big, 3, rng);
+        families.push_back({"sf-1000-3", Graph(big, e1), Graph(big, e2)});
+    }
+    return families;
+}
+
+// ============================================================================
+// MEDICIÓN
+// ============================================================================
+
+using Clock = std::chrono::steady_clock;
+
+template <class F>
+static double time_batch(F& op, long long batch) {
+    const auto start = Clock::now();
+    for (long long i = 0; i < batch; ++i) op();
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+template <class F>
+static void measure(const std::string& name, const Family& family, F op,
+                    const Options& opts, std::vector<Result>& results) {
+    if (!opts.filter.empty() &&
+        (name + "/" + family.name).find(opts.filter) == std::string::npos) {
+        return;
+    }
+
+    // Lote que dure al menos min_time
+    long long batch = 1;
+    double elapsed = time_batch(op, batch);
+    while (elapsed < opts.min_time && batch < (1LL << 40)) {
+        const double grow = elapsed > 0 ? 1.4 * opts.min_time / elapsed : 10.0;
+        batch = std::max(batch + 1, static_cast<long long>(batch * std::min(grow, 10.0)));
+        elapsed = time_batch(op, batch);
+    }
+
+    std::vector<double> per_op;
+    for (int r = 0; r < opts.repetitions; ++r) {
+        per_op.push_back(time_batch(op, batch) * 1e9 / static_cast<double>(batch));
+    }
+    std::sort(per_op.begin(), per_op.end());
+
+    Result res{name, family.name, family.g1.num_vertices(), family.g2.num_vertices(),
+               batch, opts.repetitions, per_op[per_op.size() / 2], per_op.front(),
+               per_op.back()};
+    std::cout << std::left << std::setw(30) << name << std::setw(14) << family.name
+              << std::right << std::setw(16) << std::fixed << std::setprecision(1)
+              << res.median_ns << std::setw(16) << res.min_ns << std::setw(12)
+              << batch << "\n";
+    results.push_back(res);
+}
+
+// ============================================================================
+// BENCHMARKS
+// ============================================================================
+
+static void bench_feasibility(const Family& f, const Options& opts,
+                              std::vector<Result>& results) {
+    const std::size_t n1 = f.g1.num_vertices();
+    const std::size_t n2 = f.g2.num_vertices();
+    Rng rng(7);
+
+    // Mapeo aleatorio con una cuarta parte de los vértices
+    std::vector<Vertex> p1(n1), p2(n2);
+    std::iota(p1.begin(), p1.end(), 0);
+    std::iota(p2.begin(), p2.end(), 0);
+    for (std::size_t i = n1; i > 1; --i) std::swap(p1[i - 1], p1[rng() % i]);
+    for (std::size_t i = n2; i > 1; --i) std::swap(p2[i - 1], p2[rng() % i]);
+    const std::size_t k = std::min(n1, n2) / 4;
+    Mapping mapping(n1, n2);
+    for (std::size_t i = 0; i < k; ++i) mapping.add_pair(p1[i], p2[i]);
+
+    // Consultas sobre pares libres
+    std::vector<std::pair<Vertex, Vertex>> queries;
+    for (int i = 0; i < 4096; ++i) {
+        queries.emplace_back(p1[k + rng() % (n1 - k)], p2[k + rng() % (n2 - k)]);
+    }
+
+    std::size_t next = 0;
+    measure("mapping/is_feasible_add", f, [&] {
+        const auto& [u, v] = queries[next++ & 4095];
+        keep(mapping.is_feasible_add(u, v, f.g1, f.g2));
+    }, opts, results);
+}
+
+static void bench_construction(const Family& f, const Options& opts,
+                               std::vector<Result>& results) {
+    const PheromoneMatrix pheromone(f.g1.num_vertices(), f.g2.num_vertices());
+    Ant ant;
+    Mapping out;
+    std::uint64_t seed = 0;
+
+    measure("ant/construct_solution", f, [&] {
+        ant.reseed(stream_seed(1, 0, seed++));
+        ant.construct_solution(f.g1, f.g2, pheromone, 1.0, 3.0, out);
+        keep(out.size());
+    }, opts, results);
+}
+
+static void bench_evaporation(const Family& f, const Options& opts,
+                              std::vector<Result>& results) {
+    for (bool lazy : {true, false}) {
+        PheromoneMatrix pheromone(f.g1.num_vertices(), f.g2.num_vertices(), 1.0, lazy);
+        int calls = 0;
+        measure(lazy ? "pheromone/evaporate_lazy" : "pheromone/evaporate_eager", f, [&] {
+            // Reinicio periódico para no medir números subnormales
+            if (++calls % 1000 == 0) pheromone.reset(1.0);
+            pheromone.evaporate(0.1);
+            keep(pheromone.get(0, 0));
+        }, opts, results);
+    }
+}
+
+static void bench_reader(const Family& f, const Options& opts,
+                         std::vector<Result>& results) {
+    namespace fs = std::filesystem;
+    const fs::path text = fs::temp_directory_path() / ("mcs_bench_" + f.name + ".txt");
+    {
+        std::ofstream out(text);
+        for (Vertex u = 0; u < static_cast<Vertex>(f.g1.num_vertices()); ++u) {
+            f.g1.for_each_neighbor(u, [&](Vertex v) {
+                if (u < v) out << 'v' << u << " v" << v << '\n';
+            });
+        }
+    }
+    const std::string text_path = text.string();
+    const std::string cache_path = text_path + GRAPH_CACHE_EXTENSION;
+    fs::remove(cache_path);
+
+    measure("reader/read_graph", f, [&] {
+        Reader reader;
+        keep(reader.read_graph(text_path).num_vertices());
+    }, opts, results);
+
+    {
+        Reader writer;
+        writer.set_write_cache(true);
+        writer.read_graph(text_path);
+    }
+    measure("reader/read_graph_cache", f, [&] {
+        Reader reader;
+        keep(reader.read_graph(text_path).num_vertices());
+    }, opts, results);
+
+    fs::remove(cache_path);
+    fs::remove(text);
+}
+
+static void bench_solve(const Family& f, const Options& opts,
+                        std::vector<Result>& results) {
+    ACOParams params;
+    params.num_ants = 10;
+    params.max_iterations = 10;
+    params.seed = 1;
+    params.num_threads = 1;
+    params.verbose = false;
+
+    measure("aco/solve", f, [&] {
+        ACO aco(f.g1, f.g2, params);
+        keep(aco.solve().size());
+    }, opts, results);
+}
+
+// ============================================================================
+// SALIDA JSON
+// ============================================================================
+
+static void write_json(const std::string& path, const Options& opts,
+                       const std::vector<Result>& results) {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "Error: no se puede crear " << path << "\n";
+        std::exit(1);
+    }
+
+    char date[32];
+    const std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof date, "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+#ifdef _OPENMP
+    const int threads = omp_get_max_threads();
+#else
+    const int threads = 1;
+#endif
+
+    out << "{\n  \"context\": {\n";
+    out << "    \"version\": \"" << MCS_VERSION << "\",\n";
+    out << "    \"date\": \"" << date << "\",\n";
+#if defined(__VERSION__)
+    out << "    \"compiler\": \"" << __VERSION__ << "\",\n";
+#endif
+    out << "    \"omp_threads\": " << threads << ",\n";
+    out << "    \"min_time\": " << opts.min_time << ",\n";
+    out << "    \"repetitions\": " << opts.repetitions << "\n";
+    out << "  },\n  \"benchmarks\": [\n";
+    out << std::fixed << std::setprecision(1);
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        out << "    {\"name\": \"" << r.name << "\", \"family\": \"" << r.family
+            << "\", \"n1\": " << r.n1 << ", \"n2\": " << r.n2
+            << ", \"batch\": " << r.batch << ", \"repetitions\": " << r.repetitions
+            << ", \"ns_per_op_median\": " << r.median_ns
+            << ", \"ns_per_op_min\": " << r.min_ns
+            << ", \"ns_per_op_max\": " << r.max_ns << "}"
+            << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n}\n";
+}
+
+int main(int argc, char* argv[]) {
+    Options opts;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--json" && i + 1 < argc) {
+            opts.json_path = argv[++i];
+        } else if (arg == "--filter" && i + 1 < argc) {
+            opts.filter = argv[++i];
+        } else if (arg == "--min-time" && i + 1 < argc) {
+            opts.min_time = std::atof(argv[++i]);
+        } else if (arg == "--repetitions" && i + 1 < argc) {
+            opts.repetitions = std::max(1, std::atoi(argv[++i]));
+        } else {
+            std::cerr << "Uso: " << argv[0]
+                      << " [--json archivo] [--filter texto] [--min-time s] [--repetitions n]\n";
+            return arg == "--help" || arg == "-h" ? 0 : 1;
+        }
+    }
+
+    std::cout << "mcs_bench " << MCS_VERSION << "\n";
+    std::cout << std::left << std::setw(30) << "benchmark" << std::setw(14) << "familia"
+              << std::right << std::setw(16) << "ns/op (mediana)" << std::setw(16)
+              << "ns/op (min)" << std::setw(12) << "lote" << "\n";
+
+    const std::vector<Family> families = make_families();
+    std::vector<Result> results;
+    for (const Family& f : families) {
+        bench_feasibility(f, opts, results);
+        bench_construction(f, opts, results);
+        bench_evaporation(f, opts, results);
+        bench_reader(f, opts, results);
+        bench_solve(f, opts, results);
+    }
+
+    if (!opts.json_path.empty()) {
+        write_json(opts.json_path, opts, results);
+        std::cout << "Resultados en " << opts.json_path << "\n";
+    }
+    return 0;
+}
@@ -1,13 +1,23 @@
 #pragma once
+#include "anytime.hpp"
 #include "graph.hpp"
 #include "mapping.hpp"
 #include "pheromone.hpp"
 #include "ant.hpp"
+#include "local_search.hpp"
+#include "rng.hpp"
+#include "telemetry.hpp"
+#include <functional>
+#include <utility>
 #include <vector>
-#include <random>
 
 namespace mcs {
 
+/**
+ * @brief A qué soluciones se aplica la búsqueda local tras la construcción.
+ */
+enum class LocalSearchMode { None, Best, All };
+
 /**
  * @brief Parámetros configurables del algoritmo de Colonia de Hormigas (ACO).
  *
@@ -17,7 +27,33 @@ namespace mcs {
  * - alpha: peso de la feromona (influencia en la probabilidad de selección).
  * - beta: peso de la heurística (influencia de la información heurística).
  * - rho: tasa de evaporación de la feromona (valores en [0,1]).
- * - seed: semilla para el generador de números aleatorios.
+ * - seed: semilla para el generador de números aleatorios. Cada hormiga usa
+ *   un flujo derivado de (seed, iteración, hormiga), de modo que el resultado
+ *   no depende del número de hilos.
+ * - lazy_evaporation: evaporación O(1) con factor de escala global; si es
+ *   false se multiplica la matriz completa en cada iteración.
+ * - pheromone_storage: matriz densa n1 × n2 o tabla dispersa (Auto elige
+ *   según el tamaño de la matriz densa).
+ *
+ * - local_search: búsqueda local ((1,2)-swap + tabú) sobre ninguna solución,
+ *   la mejor de cada iteración o todas.
+ * - local_search_steps: pasos sin mejora antes de cortar la búsqueda local.
+ * - mmas: MAX-MIN Ant System. Solo deposita la mejor hormiga de cada
+ *   iteración y las feromonas se acotan a [tau_min, tau_max], calculados a
+ *   partir de la mejor puntuación y rho.
+ * - restart_convergence: con mmas, si el factor de convergencia (revisado
+ *   cada 25 iteraciones) llega a este valor y la mejor solución lleva al
+ *   menos 50 iteraciones sin mejorar, las feromonas se reinician a tau_max.
+ *   1 o más desactiva los reinicios.
+ * - num_threads: hilos de la construcción paralela (0 = los de OpenMP).
+ * - verbose: imprimir encabezado y resumen en solve().
+ *
+ * Criterios de parada anticipada (se revisan entre iteraciones; 0 = desactivado):
+ * - max_stagnation: iteraciones consecutivas sin mejorar la mejor solución.
+ * - time_limit: tiempo máximo de búsqueda en segundos.
+ * - target_size: detenerse al alcanzar una solución con ese número de vértices.
+ * Además la búsqueda termina siempre al llegar a la cota min(n1, n2), que
+ * garantiza la optimalidad.
  */
 struct ACOParams {
     int num_ants = 14;
@@ -26,8 +62,35 @@ struct ACOParams {
     double beta = 3.0;
     double rho = 0.1;
     int seed = 42;
+    bool lazy_evaporation = true;
+    PheromoneStorage pheromone_storage = PheromoneStorage::Auto;
+    int max_stagnation = 0;
+    double time_limit = 0.0;
+    int target_size = 0;
+    LocalSearchMode local_search = LocalSearchMode::None;
+    int local_search_steps = 50;
+    bool mmas = false;
+    double restart_convergence = 0.999;
+    int num_threads = 0;
+    bool verbose = true;
+};
+
+/**
+ * @brief Estado de la búsqueda que recibe el callback de progreso.
+ *
+ * iteration cuenta las iteraciones terminadas (por isla en el modelo de
+ * islas) y seconds el tiempo desde el inicio de solve().
+ */
+struct ACOProgress {
+    int iteration = 0;
+    int best_size = 0;
+    int best_edges = 0;
+    double seconds = 0.0;
 };
 
+/// Se llama entre iteraciones (entre migraciones con islas); false cancela la búsqueda.
+using ProgressCallback = std::function<bool(const ACOProgress&)>;
+
 /**
  * @brief Implementación del algoritmo ACO para el problema MCIS (Maximum Common Induced Subgraph).
  *
@@ -48,8 +111,9 @@ public:
     /**
      * @brief Ejecuta el algoritmo ACO y devuelve la mejor asignación (Mapping) encontrada.
      *
-     * El método ejecuta hasta params_.max_iterations iteraciones (o criterio de parada interno)
-     * y actualiza internamente best_solution_.
+     * El método ejecuta hasta params_.max_iterations iteraciones, o menos si se
+     * cumple alguno de los criterios de parada de ACOParams o se alcanza la cota
+     * superior min(n1, n2), y actualiza internamente best_solution_.
      *
      * @return Mapping mejor mapeo encontrado entre vértices de g1 y g2.
      */
@@ -63,34 +127,117 @@ public:
     const Mapping& get_best_solution() const { return best_solution_; }
 
     /**
-     * @brief Historial de convergencia (por ejemplo puntuación por iteración).
+     * @brief Historial de convergencia: mejor tamaño tras cada iteración.
      *
-     * Se expone para fines de análisis/plotting.
+     * Se expone para fines de análisis/plotting; solve() lo reinicia.
      */
     const std::vector<int>& get_convergence_history() const {
         return convergence_history_;
     }
 
+    /// Iteraciones ejecutadas en la última llamada a solve().
+    int get_iterations_run() const { return iterations_run_; }
+
+    /// Cota superior del tamaño del MCIS: min(n1, n2).
+    int upper_bound() const;
+
+    /// Reinicios de feromonas (MMAS) en la última llamada a solve().
+    int get_restarts() const { return restarts_; }
+
+    /// Callback de progreso/cancelación para solve() (vacío = ninguno).
+    void set_progress(ProgressCallback callback) { progress_ = std::move(callback); }
+
+    /// true si el callback de progreso o el token detuvieron la última llamada a solve().
+    bool was_cancelled() const { return cancelled_; }
+
+    /**
+     * @brief Token revisado antes de construir cada hormiga (nullptr = ninguno).
+     *
+     * Al cancelarse, la iteración en curso solo considera las hormigas ya
+     * construidas, no actualiza feromonas y solve() termina enseguida.
+     */
+    void set_cancellation(const CancellationToken* token) { cancel_ = token; }
+
+    /// Publica ahí cada mejora de la mejor solución (nullptr = no publicar).
+    void set_anytime(AnytimeBest* sink) { anytime_ = sink; }
+
+    /**
+     * @brief Envía las estadísticas de cada iteración a sink (nullptr lo desactiva).
+     *
+     * El sink no se adueña: debe vivir mientras la colonia itere. Solo con
+     * sink se calculan la media de las hormigas y la entropía de las feromonas
+     * (esta recorre la matriz, así que se recalcula cada pocas iteraciones).
+     *
+     * @param colony Identificador de la colonia en los registros (islas).
+     */
+    void set_telemetry(TelemetryWriter* sink, int colony = 0) {
+        telemetry_ = sink;
+        colony_ = colony;
+    }
+
+    /**
+     * @brief Ejecuta una sola iteración, para controlar la búsqueda desde fuera
+     * (por ejemplo el modelo de islas). No revisa criterios de parada.
+     *
+     * @return true si la iteración mejoró la mejor solución.
+     */
+    bool step();
+
+    /**
+     * @brief Ofrece una solución externa (migrante).
+     *
+     * Si supera a la mejor propia la reemplaza y refuerza sus pares.
+     *
+     * @return true si se aceptó.
+     */
+    bool accept_migrant(const Mapping& migrant);
+
+    int get_best_score() const { return best_score_; }
+    int get_best_edges() const { return best_edges_; }
+
+    PheromoneMatrix& pheromone() { return pheromone_; }
+    const PheromoneMatrix& pheromone() const { return pheromone_; }
+
 private:
     const Graph& g1_;
     const Graph& g2_;
     ACOParams params_;
 
     PheromoneMatrix pheromone_;
-    std::mt19937 rng_;
+    Rng rng_;
 
     Mapping best_solution_;
     int best_score_;
     int best_edges_;
+    int iterations_run_ = 0;
+    int restarts_ = 0;
+    int last_improvement_ = 0;
 
     std::vector<int> convergence_history_;
+    TelemetryWriter* telemetry_ = nullptr;
+    int colony_ = 0;
+    double telemetry_entropy_ = 0.0;  // última entropía calculada
+    ProgressCallback progress_;
+    bool cancelled_ = false;
+    const CancellationToken* cancel_ = nullptr;
+    AnytimeBest* anytime_ = nullptr;
+
+    // Estado reutilizado entre iteraciones: una hormiga (con sus búferes) por
+    // hilo y una solución por hormiga. Tras la primera iteración no se asigna
+    // memoria en el ciclo principal.
+    std::vector<Ant> workers_;
+    std::vector<LocalSearch> searchers_;  // uno por hilo (si hay búsqueda local)
+    std::vector<Mapping> solutions_;
+    std::vector<int> scores_;
+    std::vector<int> edges_;
 
     /**
      * @brief Ejecuta una iteración completa del algoritmo (construcción de soluciones y actualización local).
      *
      * @param iter Índice (0-based) de la iteración actual.
+     * @return true si la iteración mejoró la mejor solución.
      */
-    void run_iteration(int iter);
+    bool run_iteration(int iter);
 
     /**
      * @brief Actualiza la matriz de feromonas en base a las soluciones generadas en la iteración.
@@ -99,9 +246,29 @@ private:
      *
      * @param solutions Vector con las mappings construidas por las hormigas.
      * @param scores Vector con la calidad (puntuación) correspondiente a cada mapping.
+     * @param iteration_best Índice de la mejor hormiga de la iteración (MMAS).
      */
     void update_pheromones(const std::vector<Mapping>& solutions,
-                          const std::vector<int>& scores);
+                          const std::vector<int>& scores,
+                          int iteration_best);
+
+    /**
+     * @brief Recalcula tau_min / tau_max de MMAS a partir de best_score_ y rho.
+     *
+     * La primera vez (y en cada reinicio) la matriz se lleva a tau_max.
+     */
+    void update_bounds();
+
+    /// Reinicia las feromonas si la colonia convergió (MMAS).
+    void check_restart(int iter);
+
+    bool cancel_requested() const { return cancel_ && cancel_->is_cancelled(); }
+
+    /// Copia best_solution_ a anytime_, si hay.
+    void publish_best(int iter);
+
+    /// Registra la iteración recién terminada en telemetry_.
+    void record_telemetry(int iter, double seconds);
 };
 
 } // namespace mcs
\ No newline at end of file
@@ -2,15 +2,24 @@
 #include "graph.hpp"
 #include "mapping.hpp"
 #include "pheromone.hpp"
-#include <random>
+#include "power.hpp"
+#include "rng.hpp"
 #include <vector>
 #include <utility>
 
 namespace mcs {
 
+/**
+ * @brief Hormiga: construye soluciones y conserva sus búferes de trabajo.
+ *
+ * Una misma Ant puede reutilizarse para muchas construcciones (reseed entre
+ * una y otra); tras la primera, construir no asigna memoria.
+ */
 class Ant {
 public:
-    explicit Ant(std::mt19937& rng) : rng_(rng) {}
+    explicit Ant(std::uint64_t seed = 0) : rng_(seed) {}
+
+    void reseed(std::uint64_t seed) { rng_.seed(seed); }
 
     Mapping construct_solution(
         const Graph& g1,
@@ -20,10 +29,79 @@ public:
         double beta
     );
 
+    /// Igual que la anterior, pero escribe la solución en out (se reutiliza).
+    void construct_solution(
+        const Graph& g1,
+        const Graph& g2,
+        const PheromoneMatrix& pheromone,
+        double alpha,
+        double beta,
+        Mapping& out
+    );
+
 private:
-    std::mt19937& rng_;
+    Rng rng_;
+
+    // Búfer para repair_to_induced (se intercambia con la salida)
+    Mapping repair_buf_;
+
+    // Vértices no mapeados (muestreo con rechazo)
+    std::vector<Vertex> unmapped_g1_;
+    std::vector<Vertex> unmapped_g2_;
+
+    // ------------------------------------------------------------------
+    // Dominios incrementales (forward-checking)
+    // ------------------------------------------------------------------
+    // Para cada u de g1, bits de los v de g2 tales que (u,v) sigue siendo
+    // factible con el mapeo actual. Solo se usan si g2 es densa y la tabla
+    // cabe en DOMAIN_LIMIT_BYTES; si no, se recurre al muestreo con rechazo.
+    bool use_domains_ = false;
+    std::size_t domain_words_ = 0;
+    std::vector<Word> domains_;        // n1 × domain_words_
+    std::vector<int> domain_size_;     // popcount de cada dominio
+    std::vector<long long> prefix_;    // sumas prefijas de domain_size_
+
+    // Pool de candidatos como estructura de arreglos: los pesos se calculan
+    // con ciclos contiguos sobre tau y eta.
+    struct Pool {
+        std::vector<Vertex> u, v;
+        std::vector<double> tau, eta;
 
-    // Calcula heurística combinada: verificación + grado
+        std::size_t size() const { return u.size(); }
+        bool empty() const { return u.empty(); }
+        void clear() { u.clear(); v.clear(); }
+        void push(Vertex a, Vertex b) { u.push_back(a); v.push_back(b); }
+    };
+    Pool pool_;
+
+    // x^alpha y x^beta resueltos una vez por construcción
+    PowerKernel tau_pow_;
+    PowerKernel eta_pow_;
+
+    void init_domains(const Graph& g1, const Graph& g2);
+
+    // Restringe los dominios tras agregar (u,v): O(n1 · n2/64) palabras.
+    void update_domains(Vertex u, Vertex v, const Graph& g1, const Graph& g2);
+
+    // Llena pool_ con pares factibles tomados de los dominios (sin rechazo).
+    void sample_from_domains(std::size_t k);
+
+    // Llena pool_ muestreando pares al azar y filtrando con is_feasible_add.
+    void sample_by_rejection(const Mapping& current,
+                             const Graph& g1,
+                             const Graph& g2,
+                             std::size_t k);
+
+    // Vecinos ya mapeados de cada vértice, actualizados en cada add_pair.
+    // Para un candidato factible (u,v) todo vecino mapeado de u corresponde a
+    // un vecino mapeado de v, así que preserved = c1[u] y mism = 0.
+    std::vector<int> mapped_nbrs_g1_;
+    std::vector<int> mapped_nbrs_g2_;
+
+    void record_pair(Vertex u, Vertex v, const Graph& g1, const Graph& g2);
+
+    // Calcula heurística combinada: verificación + grado. O(1) con los
+    // contadores; supone (u,v) factible, como todos los candidatos del pool.
     double compute_heuristic(
         Vertex u,
         Vertex v,
@@ -32,13 +110,13 @@ private:
         const Graph& g2
     ) const;
 
+    // Usa tau_pow_/eta_pow_, resueltos en construct_solution a partir de
+    // alpha y beta.
     std::pair<Vertex, Vertex> select_next_pair(
         const Mapping& current,
         const Graph& g1,
         const Graph& g2,
-        const PheromoneMatrix& pheromone,
-        double alpha,
-        double beta
+        const PheromoneMatrix& pheromone
     );
 
     std::vector<double> compute_probabilities(
@@ -0,0 +1,69 @@
+#pragma once
+#include "mapping.hpp"
+#include <atomic>
+#include <memory>
+
+namespace mcs {
+
+/**
+ * @brief Bandera de cancelación cooperativa, segura entre hilos.
+ *
+ * Cualquier hilo llama a cancel(); los solvers la revisan en puntos
+ * seguros (el ACO antes de construir cada hormiga, McSplit junto con el
+ * límite de tiempo) y terminan con la mejor solución que tengan.
+ */
+class CancellationToken {
+public:
+    void cancel() { cancelled_.store(true, std::memory_order_relaxed); }
+    void reset() { cancelled_.store(false, std::memory_order_relaxed); }
+    bool is_cancelled() const { return cancelled_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<bool> cancelled_{false};
+};
+
+/// Mejor solución publicada hasta cierto momento (inmutable una vez publicada).
+struct SolutionSnapshot {
+    Mapping mapping;
+    int size = 0;
+    int edges = 0;
+    int iteration = 0;  // iteración del ACO que la encontró (-1 = exacto)
+};
+
+/**
+ * @brief Mejor solución "en cualquier momento", legible desde otro hilo.
+ *
+ * Cada publicación es una instantánea nueva e inmutable; el puntero se
+ * cambia con las operaciones atómicas de std::shared_ptr, así que quien
+ * lee con get() se queda con una copia válida aunque el solver publique
+ * otra enseguida (no hay búfer que se reescriba bajo el lector). Varias
+ * colonias pueden publicar a la vez: offer() solo reemplaza si la nueva
+ * es mejor (más vértices; a igualdad, más aristas).
+ */
+class AnytimeBest {
+public:
+    /// Instantánea actual (nullptr si aún no hay ninguna).
+    std::shared_ptr<const SolutionSnapshot> get() const {
+        return std::atomic_load(&best_);
+    }
+
+    /// Publica snapshot si mejora la actual; true si se publicó.
+    bool offer(std::shared_ptr<const SolutionSnapshot> snapshot) {
+        std::shared_ptr<const SolutionSnapshot> current = get();
+        do {
+            if (current && !better(*snapshot, *current)) return false;
+        } while (!std::atomic_compare_exchange_weak(&best_, &current, snapshot));
+        return true;
+    }
+
+    void reset() { std::atomic_store(&best_, std::shared_ptr<const SolutionSnapshot>()); }
+
+private:
+    std::shared_ptr<const SolutionSnapshot> best_;
+
+    static bool better(const SolutionSnapshot& a, const SolutionSnapshot& b) {
+        return a.size > b.size || (a.size == b.size && a.edges > b.edges);
+    }
+};
+
+} // namespace mcs
@@ -0,0 +1,81 @@
+#pragma once
+#include "aco.hpp"
+#include "graph.hpp"
+#include "mcs.hpp"
+#include <string>
+#include <vector>
+
+namespace mcs {
+
+/**
+ * @brief Opciones del modo por lotes.
+ *
+ * - solver: motor usado para cada par (con un solo hilo por par).
+ * - storage: almacenamiento de la adyacencia de todas las gráficas.
+ * - csv_path: archivo CSV de resultados (vacío = salida estándar).
+ * - matrix_path: matriz binaria de similitud (vacío = no se escribe).
+ * - write_cache: escribir el caché .mcsg de cada gráfica leída como texto.
+ */
+struct BatchParams {
+    Solver solver = Solver::Aco;
+    GraphStorage storage = GraphStorage::Auto;
+    std::string csv_path;
+    std::string matrix_path;
+    bool write_cache = false;
+};
+
+/**
+ * @brief Archivos de gráficas a partir de un directorio (todos sus archivos
+ * regulares en orden alfabético, salvo los cachés .mcsg de otro archivo
+ * del directorio) o de una lista (una ruta por línea; se ignoran las líneas
+ * vacías y las que empiezan con '#').
+ */
+std::vector<std::string> list_graph_files(const std::string& path);
+
+/**
+ * @brief MCIS de muchos pares de gráficas en un solo proceso.
+ *
+ * Cada gráfica se lee una sola vez (en paralelo). Los pares se reparten
+ * entre los hilos con planificación dinámica y dentro de cada par las
+ * hormigas son secuenciales. Cada resultado se escribe en cuanto termina
+ * como una línea CSV:
+ *
+ *     fila,columna,g1,g2,n1,n2,mcis,aristas,similitud,segundos
+ *
+ * con similitud = mcis / max(n1, n2). Las líneas salen en orden de
+ * terminación; fila y columna identifican la celda de la matriz.
+ *
+ * La matriz binaria es "MCSM", uint32 versión (1), uint32 filas,
+ * uint32 columnas y filas × columnas float32 (por filas, orden de bytes
+ * nativo).
+ */
+class BatchRunner {
+public:
+    BatchRunner(const ACOParams& params, const BatchParams& batch);
+
+    /// Una consulta contra cada objetivo: matriz 1 × N.
+    void run_query(const std::string& query,
+                   const std::vector<std::string>& targets);
+
+    /// Todos contra todos: matriz N × N simétrica (la diagonal no se calcula).
+    void run_all_pairs(const std::vector<std::string>& files);
+
+private:
+    ACOParams params_;
+    BatchParams batch_;
+
+    std::vector<Graph> load(const std::vector<std::string>& files) const;
+
+    SolveResult solve_pair(const Graph& g1, const Graph& g2) const;
+
+    void run(const std::vector<std::string>& row_files,
+             const std::vector<Graph>& rows,
+             const std::vector<std::string>& col_files,
+             const std::vector<Graph>& cols,
+             bool symmetric);
+
+    void write_matrix(const std::vector<float>& matrix,
+                      std::size_t rows, std::size_t cols) const;
+};
+
+} // namespace mcs
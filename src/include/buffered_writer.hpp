@@ -0,0 +1,78 @@
+#pragma once
+#include <charconv>
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace mcs {
+
+/**
+ * @brief Escritura a archivo a través de un búfer grande propio.
+ *
+ * Los textos y enteros se copian al búfer (los enteros con std::to_chars,
+ * sin std::string temporales) y el archivo solo recibe bloques completos,
+ * de modo que la salida cuesta O(bytes) sin importar cuántas piezas la
+ * formen. El búfer se reutiliza entre vaciados.
+ */
+class BufferedWriter {
+public:
+    static constexpr std::size_t DEFAULT_CAPACITY = std::size_t{1} << 20;
+
+    explicit BufferedWriter(const std::string& filename,
+                            std::size_t capacity = DEFAULT_CAPACITY);
+    ~BufferedWriter();
+
+    BufferedWriter(const BufferedWriter&) = delete;
+    BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+    bool is_open() const { return out_.is_open(); }
+
+    BufferedWriter& operator<<(std::string_view text) {
+        if (text.size() > buffer_.size() - used_) {
+            flush();
+            if (text.size() > buffer_.size()) {
+                out_.write(text.data(), static_cast<std::streamsize>(text.size()));
+                return *this;
+            }
+        }
+        text.copy(buffer_.data() + used_, text.size());
+        used_ += text.size();
+        return *this;
+    }
+
+    BufferedWriter& operator<<(char c) {
+        if (used_ == buffer_.size()) flush();
+        buffer_[used_++] = c;
+        return *this;
+    }
+
+    template <class T, class = std::enable_if_t<std::is_integral_v<T> &&
+                                              !std::is_same_v<T, bool>>>
+    BufferedWriter& operator<<(T value) {
+        if (buffer_.size() - used_ < 24) flush();
+        char* first = buffer_.data() + used_;
+        used_ = static_cast<std::size_t>(
+            std::to_chars(first, buffer_.data() + buffer_.size(), value).ptr -
+            buffer_.data());
+        return *this;
+    }
+
+    /// Vacía el búfer en el archivo.
+    void flush();
+
+    /// Vacía el búfer y el del ofstream, para que otro proceso ya lea lo escrito.
+    void sync();
+
+    /// Vacía y cierra; false si hubo algún error de escritura.
+    bool close();
+
+private:
+    std::ofstream out_;
+    std::vector<char> buffer_;
+    std::size_t used_ = 0;
+};
+
+} // namespace mcs
@@ -1,30 +1,175 @@
 #pragma once
 #include <vector>
+#include <utility>
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 
 namespace mcs {
 
 using Vertex = int;
 
+/// Palabra de 64 bits usada para empaquetar filas de adyacencia y conjuntos.
+using Word = std::uint64_t;
+constexpr std::size_t WORD_BITS = 64;
+
+/// Número de palabras necesarias para representar n bits.
+inline std::size_t words_for(std::size_t n) {
+    return (n + WORD_BITS - 1) / WORD_BITS;
+}
+
+inline int popcount(Word w) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(w);
+#else
+    int c = 0;
+    for (; w; w &= w - 1) ++c;
+    return c;
+#endif
+}
+
+/// Índice del bit encendido menos significativo (w != 0).
+inline int lowest_bit(Word w) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(w);
+#else
+    int i = 0;
+    while (!(w & 1)) { w >>= 1; ++i; }
+    return i;
+#endif
+}
+
+/**
+ * @brief Representación interna de la adyacencia.
+ *
+ * - Dense: filas de bits, n²/8 bytes. Ideal para gráficas pequeñas o densas.
+ * - Sparse: CSR (compressed sparse row) con vecinos ordenados, O(|V| + |E|).
+ * - Auto: elige Sparse cuando la matriz de bits sería grande y mucho mayor
+ *   que el CSR equivalente.
+ */
+enum class GraphStorage { Dense, Sparse, Auto };
+
+/// Rango de vecinos ordenados de un vértice (solo almacenamiento disperso).
+struct NeighborRange {
+    const Vertex* first;
+    const Vertex* last;
+
+    const Vertex* begin() const { return first; }
+    const Vertex* end() const { return last; }
+    std::size_t size() const { return static_cast<std::size_t>(last - first); }
+};
+
+/**
+ * @brief Gráfica no dirigida con adyacencia densa (bits) o dispersa (CSR).
+ *
+ * En modo denso cada vértice tiene una fila de words_per_row() palabras de 64
+ * bits, de modo que las comparaciones contra conjuntos de vértices (por
+ * ejemplo, los vértices ya mapeados) se hacen palabra a palabra. En modo
+ * disperso la memoria escala con |E| y edge() es una búsqueda binaria.
+ */
 class Graph {
 public:
     using Vertex = int;
 
+    /// Gráfica densa vacía con n vértices; las aristas se agregan con add_edge.
     explicit Graph(std::size_t n);
 
+    /// Construye la gráfica a partir de una lista de aristas (se ignoran repetidas).
+    Graph(std::size_t n,
+          const std::vector<std::pair<Vertex, Vertex>>& edges,
+          GraphStorage storage = GraphStorage::Auto);
+
+    /**
+     * @brief Gráfica densa sobre arreglos externos, sin copiarlos.
+     *
+     * adj tiene n × words_for(n) palabras y degrees n enteros; backing los
+     * mantiene vivos (por ejemplo, un archivo mapeado en memoria).
+     */
+    static Graph dense_view(std::size_t n, const Word* adj, const int* degrees,
+                            std::shared_ptr<const void> backing);
+
+    /// Gráfica dispersa (CSR) sobre arreglos externos, sin copiarlos.
+    static Graph sparse_view(std::size_t n, const std::size_t* offsets,
+                             const Vertex* targets, const int* degrees,
+                             std::shared_ptr<const void> backing);
+
+    Graph(const Graph& other);
+    Graph& operator=(const Graph& other);
+    Graph(Graph&&) = default;
+    Graph& operator=(Graph&&) = default;
+
+    /// Solo válido en almacenamiento denso propio (lanza std::logic_error si no).
     void add_edge(Vertex u, Vertex v);
 
-    bool edge(Vertex u, Vertex v) const;
+    bool edge(Vertex u, Vertex v) const {
+        if (dense_) return (row(u)[v / WORD_BITS] >> (v % WORD_BITS)) & 1u;
+        return sparse_edge(u, v);
+    }
 
-    int degree(Vertex u) const { return degrees_[u]; }  // ← O(1)
+    int degree(Vertex u) const { return degrees_data_[u]; }  // ← O(1)
 
     std::size_t num_vertices() const;
 
+    bool is_dense() const { return dense_; }
+
+    /// Palabras por fila de adyacencia (solo almacenamiento denso).
+    std::size_t words_per_row() const { return words_; }
+
+    /// Fila de adyacencia completa de u (solo almacenamiento denso).
+    const Word* row(Vertex u) const {
+        return adj_data_ + static_cast<std::size_t>(u) * words_;
+    }
+
+    /// Vecinos ordenados de u (solo almacenamiento disperso).
+    NeighborRange neighbors(Vertex u) const {
+        return {targets_data_ + offsets_data_[u], targets_data_ + offsets_data_[u + 1]};
+    }
+
+    /// Recorre los vecinos de u en orden creciente con cualquier almacenamiento.
+    template <class F>
+    void for_each_neighbor(Vertex u, F&& f) const {
+        if (dense_) {
+            const Word* r = row(u);
+            for (std::size_t w = 0; w < words_; ++w) {
+                for (Word bits = r[w]; bits; bits &= bits - 1) {
+                    f(static_cast<Vertex>(w * WORD_BITS + lowest_bit(bits)));
+                }
+            }
+        } else {
+            for (Vertex x : neighbors(u)) f(x);
+        }
+    }
+
 private:
     std::size_t n_;
-    std::vector<uint8_t> adj_;
+    bool dense_ = true;
+
+    // Almacenamiento denso
+    std::size_t words_ = 0;
+    std::vector<Word> adj_;
+
+    // Almacenamiento disperso (CSR)
+    std::vector<std::size_t> offsets_;
+    std::vector<Vertex> targets_;
+
     std::vector<int> degrees_;  // ← NUEVO: caché de grados
+
+    // Arreglos en uso: los propios de arriba o, en una vista, los externos
+    // que backing_ mantiene vivos (entonces los vectores quedan vacíos)
+    const Word* adj_data_ = nullptr;
+    const std::size_t* offsets_data_ = nullptr;
+    const Vertex* targets_data_ = nullptr;
+    const int* degrees_data_ = nullptr;
+    std::shared_ptr<const void> backing_;
+
+    // Apunta los arreglos en uso a los vectores propios
+    void bind();
+
+    bool sparse_edge(Vertex u, Vertex v) const {
+        const NeighborRange r = neighbors(u);
+        return std::binary_search(r.begin(), r.end(), v);
+    }
 };
 
 } // namespace mcs
@@ -0,0 +1,47 @@
+#pragma once
+#include "graph.hpp"
+#include <string>
+#include <vector>
+
+namespace mcs {
+
+/// Extensión del caché binario; el caché de "g1.txt" es "g1.txt.mcsg".
+constexpr const char* GRAPH_CACHE_EXTENSION = ".mcsg";
+
+/**
+ * @brief Escribe la gráfica ya construida en un caché binario (.mcsg).
+ *
+ * Formato (orden de bytes nativo, cada sección alineada a 64 bytes):
+ *
+ * - Encabezado de 64 bytes: "MCSG", uint32 versión (1), uint32 banderas
+ *   (bit 0 = denso), uint32 reservado, uint64 n, uint64 palabras por fila,
+ *   uint64 entradas CSR, uint64 bytes de nombres, uint64 tamaño e int64
+ *   fecha de modificación del texto de origen.
+ * - int32 grados[n].
+ * - Denso: uint64 filas[n × palabras]. Disperso: uint64 offsets[n + 1] e
+ *   int32 vecinos[entradas].
+ * - uint64 inicio de cada nombre[n + 1] y los nombres concatenados.
+ *
+ * Se escribe en un archivo temporal único (pid y contador) que luego se
+ * renombra, así que un lector concurrente nunca ve un caché a medias ni dos
+ * escritores mezclan sus bytes; si algo falla el temporal se borra y se lanza.
+ *
+ * @param source Texto del que salió la gráfica (vacío = no se valida).
+ */
+void write_graph_cache(const std::string& path, const Graph& g,
+                       const std::vector<std::string>& names,
+                       const std::string& source);
+
+/**
+ * @brief Carga un caché .mcsg con mmap; la gráfica apunta directamente al
+ * archivo mapeado (sin deserializar), que vive mientras viva la gráfica.
+ *
+ * Devuelve false, sin tocar g ni names, si el caché no existe, está
+ * dañado (se validan tamaños, offsets, vecinos y grados contra sus filas), no corresponde al tamaño y fecha actuales de source o su
+ * almacenamiento no es el pedido (Auto acepta cualquiera).
+ */
+bool load_graph_cache(const std::string& path, const std::string& source,
+                      GraphStorage storage, Graph& g,
+                      std::vector<std::string>& names);
+
+} // namespace mcs
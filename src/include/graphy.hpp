@@ -1,8 +1,8 @@
 #pragma once
+#include "buffered_writer.hpp"
 #include "graph.hpp"
 #include <string>
 #include <vector>
-#include <unordered_map>
 
 namespace mcs {
 
@@ -20,25 +20,32 @@ public:
 private:
     const Graph& graph_;
     const std::vector<std::string>& id_to_name_;
-    std::string svg_;
+
+    // Posición de cada vértice en el subconjunto dibujado (-1 = fuera);
+    // se reutiliza entre dibujos
+    std::vector<int> posicion_;
 
     static constexpr const char* INICIO =
         "<svg xmlns='http://www.w3.org/2000/svg'";
     static constexpr const char* FINAL = "</svg>\n";
 
-    std::string dimensionaLienzo(int ancho, int alto);
-    std::string dibujaArista(
+    // Cada elemento se agrega directamente al archivo (sin std::string temporales)
+    static void dimensionaLienzo(BufferedWriter& out, int ancho, int alto);
+    static void dibujaArista(
+        BufferedWriter& out,
         int x1, int y1, int x2, int y2,
-        const std::string& color, int stroke_width
+        const char* color, int stroke_width
     );
-    std::string dibujaVertice(
+    static void dibujaVertice(
+        BufferedWriter& out,
         const std::string& nombre, int x, int y,
-        const std::string& color
+        const char* color
     );
-    std::string escribe(
+    static void escribe(
+        BufferedWriter& out,
         int x, int y, const std::string& texto,
-        const std::string& color
+        const char* color
     );
 };
 
-} // namespace mcs
\ No newline at end of file
+} // namespace mcs
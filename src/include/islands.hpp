@@ -0,0 +1,91 @@
+#pragma once
+#include "aco.hpp"
+#include "graph.hpp"
+#include "mapping.hpp"
+#include <memory>
+#include <vector>
+
+namespace mcs {
+
+/// Vecinos de cada isla: anillo (i recibe de i - 1) o todos con todos.
+enum class Topology { Ring, Full };
+
+/// Qué se comparte en cada migración.
+enum class Migration { Solution, Pheromone };
+
+/**
+ * @brief Parámetros del modelo de islas.
+ *
+ * - islands: número de colonias independientes.
+ * - migration_interval: iteraciones entre migraciones.
+ * - topology: de quién recibe cada isla.
+ * - migration: Solution envía la mejor solución (que el receptor adopta si
+ *   es mejor); Pheromone mezcla la matriz del receptor con la del emisor.
+ * - blend: peso de la matriz del emisor en la mezcla.
+ */
+struct IslandParams {
+    int islands = 4;
+    int migration_interval = 25;
+    Topology topology = Topology::Ring;
+    Migration migration = Migration::Solution;
+    double blend = 0.1;
+};
+
+/**
+ * @brief Varias colonias ACO independientes con migración periódica.
+ *
+ * Cada isla tiene su propia matriz de feromonas y su propia semilla, y se
+ * ejecuta en su propio grupo de hilos (OpenMP anidado): los hilos disponibles
+ * se reparten entre las islas, así que ninguna matriz se comparte durante la
+ * construcción. Entre migraciones las islas no se comunican; la migración es
+ * secuencial y determinista, por lo que el resultado no depende del número
+ * de hilos.
+ *
+ * Los criterios de parada de ACOParams se revisan entre migraciones;
+ * max_iterations es por isla.
+ */
+class IslandModel {
+public:
+    IslandModel(const Graph& g1, const Graph& g2, const ACOParams& params,
+                const IslandParams& island_params);
+
+    Mapping solve();
+
+    /// Iteraciones ejecutadas por cada isla en la última llamada a solve().
+    int get_iterations_run() const { return iterations_run_; }
+
+    /// Callback de progreso (mejor de todas las islas), revisado entre migraciones.
+    void set_progress(ProgressCallback callback) { progress_ = std::move(callback); }
+
+    /// true si el callback de progreso o el token detuvieron la última llamada a solve().
+    bool was_cancelled() const { return cancelled_; }
+
+    /// Token compartido por todas las islas (ver ACO::set_cancellation).
+    void set_cancellation(const CancellationToken* token);
+
+    /// Todas las islas publican en el mismo sink; queda la mejor de ellas.
+    void set_anytime(AnytimeBest* sink);
+
+    /// Telemetría de todas las islas en el mismo sink (colony = índice de isla).
+    void set_telemetry(TelemetryWriter* sink);
+
+private:
+    const Graph& g1_;
+    const Graph& g2_;
+    ACOParams params_;
+    IslandParams island_params_;
+    int threads_per_island_;
+    int iterations_run_ = 0;
+    ProgressCallback progress_;
+    bool cancelled_ = false;
+    const CancellationToken* cancel_ = nullptr;
+
+    std::vector<std::unique_ptr<ACO>> colonies_;
+
+    // Isla con la mejor solución (empates: índice menor)
+    std::size_t best_island() const;
+
+    void migrate();
+};
+
+} // namespace mcs
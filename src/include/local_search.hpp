@@ -0,0 +1,102 @@
+#pragma once
+#include "graph.hpp"
+#include "mapping.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace mcs {
+
+/**
+ * @brief Búsqueda local con movimientos (1,2)-swap y lista tabú.
+ *
+ * Para cada par libre (u, v) se cuentan sus conflictos con el mapeo: los
+ * pares (x, y) ya mapeados con edge(u, x) != edge(v, y). Con bits esto es
+ * popcount(Q[u] XOR P[v]), donde Q[u] = N(u) ∩ M₁ y P[v] son los x cuya
+ * imagen es vecina de v. Movimientos, en orden de preferencia:
+ *
+ * - agregar: un par libre sin conflictos (+1);
+ * - (1,2)-swap: quitar (x, y) y agregar dos pares compatibles entre sí cuyo
+ *   único conflicto es x (+1);
+ * - (1,1)-swap: quitar (x, y) y agregar un par cuyo único conflicto es x
+ *   (meseta). Los vértices quitados quedan tabú TABU_TENURE pasos para no
+ *   deshacer el movimiento.
+ *
+ * Los movimientos que mejoran ignoran la lista tabú. La búsqueda termina tras
+ * max_steps pasos sin mejorar y deja en el mapeo el mejor encontrado. Los
+ * búferes se reutilizan entre llamadas.
+ *
+ * Los conflictos de cada par (n1 × n2 contadores) se ajustan en cada
+ * movimiento, y los pares libres con 0 o 1 conflictos se guardan en una
+ * lista, así que cada paso recorre solo esos candidatos en lugar de
+ * free1 × free2.
+ */
+class LocalSearch {
+public:
+    LocalSearch(const Graph& g1, const Graph& g2);
+
+    /**
+     * @brief Mejora el mapeo en su lugar.
+     *
+     * @param mapping Mapeo inducido válido; al terminar es el mejor encontrado.
+     * @param max_steps Pasos consecutivos sin mejora antes de detenerse.
+     * @return true si el mapeo creció.
+     */
+    bool improve(Mapping& mapping, int max_steps);
+
+    /// false si las tablas no caben en el límite de memoria (no-op).
+    bool enabled() const { return enabled_; }
+
+private:
+    /// Par libre con un solo conflicto: el vértice x de g1.
+    struct Candidate {
+        Vertex u, v;
+        Vertex conflict;
+    };
+
+    const Graph& g1_;
+    const Graph& g2_;
+    bool enabled_;
+    std::size_t words_;  // palabras por fila (vértices de g1)
+
+    // Filas de todos los vértices (mapeados o no), al día con el mapeo
+    std::vector<Word> q_;  // n1 × words_: N(u) ∩ M₁
+    std::vector<Word> p_;  // n2 × words_: {x ∈ M₁ : image(x) ∈ N(v)}
+    std::vector<Vertex> free1_, free2_;  // en orden creciente
+    std::vector<Candidate> candidates_;
+
+    // Conflictos del par u · n2 + v con el mapeo, al día para todos los pares
+    std::vector<std::uint16_t> conflicts_;
+    // Pares que pueden tener <= 1 conflicto; contiene a todos los libres que
+    // los tienen y los demás se descartan al recorrerla (listed_ evita repetir)
+    std::vector<std::uint32_t> open_;
+    std::vector<char> listed_;
+    // Vecinos del par que entra o sale (marcas temporales de flip_pair)
+    std::vector<char> near1_, near2_;
+
+    // Paso hasta el cual el vértice no puede volver a entrar en una meseta
+    std::vector<int> tabu1_, tabu2_;
+
+    Mapping best_;
+
+    // Calcula q_, p_, free1_, free2_, conflicts_ y open_ desde cero
+    void rebuild(const Mapping& mapping);
+
+    // Agrega el par a open_ si tiene <= 1 conflicto y no está ya
+    void list_pair(std::size_t pair);
+
+    // Entra (delta = +1) o sale (delta = -1) el par (x, y): invierte el bit x
+    // en las filas de N(x) y N(y) y ajusta los conflictos que cambian
+    void flip_pair(Vertex x, Vertex y, int delta);
+
+    // El único x en conflicto de un par con un conflicto
+    Vertex single_conflict(Vertex u, Vertex v) const;
+
+    // Cambian el mapeo y actualizan solo las filas de los vecinos del par
+    void add_pair(Mapping& mapping, Vertex u, Vertex v);
+    void remove_pair(Mapping& mapping, Vertex x);
+
+    // Primer (1,2)-swap disponible; candidates_ debe estar ordenado por conflicto
+    bool try_swap_12(Mapping& mapping, int step);
+};
+
+} // namespace mcs
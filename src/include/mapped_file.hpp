@@ -0,0 +1,39 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace mcs {
+
+/**
+ * @brief Archivo completo en memoria de solo lectura.
+ *
+ * Usa mmap cuando el sistema lo permite (sin copiar el contenido) y, si no,
+ * lee el archivo a un búfer propio. El contenido vive mientras viva el
+ * objeto, así que las vistas que se tomen de él no deben sobrevivirlo.
+ */
+class MappedFile {
+public:
+    /// Lanza std::runtime_error si el archivo no se puede abrir.
+    explicit MappedFile(const std::string& filename);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return data_; }
+    std::size_t size() const { return size_; }
+    std::string_view view() const { return {data_, size_}; }
+
+    /// true si el contenido está mapeado (no copiado).
+    bool is_mapped() const { return mapped_; }
+
+private:
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+    bool mapped_ = false;
+    std::vector<char> buffer_;
+};
+
+} // namespace mcs
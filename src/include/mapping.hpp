@@ -1,7 +1,5 @@
 #pragma once
 #include "graph.hpp"
-#include <unordered_map>
-#include <unordered_set>
 #include <vector>
 #include <utility>
 #include <string>
@@ -10,8 +8,19 @@ namespace mcs {
 
 using Vertex = int;
 
+/**
+ * @brief Mapeo parcial inyectivo de vértices de g1 a vértices de g2.
+ *
+ * Usa arreglos planos: image_[u] y preimage_[v] (-1 si no está mapeado) dan
+ * pertenencia O(1) sin hashing, y pairs_ guarda los pares en orden de
+ * inserción para recorrerlos de forma contigua. Un Mapping construido por
+ * defecto crece bajo demanda; conviene dimensionarlo con Mapping(n1, n2).
+ */
 class Mapping {
 public:
+    Mapping() = default;
+    Mapping(std::size_t n1, std::size_t n2);
+
     bool is_mapped_g1(Vertex u) const;
     bool is_mapped_g2(Vertex v) const;
     Vertex get_image(Vertex u) const;
@@ -24,21 +33,36 @@ public:
     void remove_pair(Vertex u);
     void clear();
 
+    /// Vacía el mapeo y lo dimensiona para n1 × n2 (reutiliza la memoria).
+    void reset(std::size_t n1, std::size_t n2);
+
     int size() const;
     int count_edges(const Graph& g1, const Graph& g2) const;
 
     std::vector<std::pair<Vertex, Vertex>> get_nodes_vector() const;
 
-    // Nueva función: exportar el MCIS como archivo de aristas
-    void export_mcis(const Graph& g1,
-                    const Graph& g2,
-                    const std::vector<std::string>& names1,
-                    const std::vector<std::string>& names2,
-                    const std::string& filename) const;
+    /// Pares (u,v) en orden de inserción, sin copiar.
+    const std::vector<std::pair<Vertex, Vertex>>& pairs() const { return pairs_; }
+
+    /**
+     * @brief Exporta el MCIS como archivo de aristas (.mcis).
+     *
+     * Devuelve false si el mapeo está vacío o no se pudo escribir el archivo.
+     */
+    bool export_mcis(const Graph& g1,
+                     const Graph& g2,
+                     const std::vector<std::string>& names1,
+                     const std::vector<std::string>& names2,
+                     const std::string& filename) const;
 
 private:
-    std::unordered_map<Vertex, Vertex> mapping_;
-    std::unordered_set<Vertex> mapped_g2_;
+    std::vector<Vertex> image_;      // g1 → g2
+    std::vector<Vertex> preimage_;   // g2 → g1
+    std::vector<std::pair<Vertex, Vertex>> pairs_;
+
+    // Conjuntos de vértices mapeados empaquetados en bits (ver Graph::row)
+    std::vector<Word> mask_g1_;
+    std::vector<Word> mask_g2_;
 };
 
 } // namespace mcs
\ No newline at end of file
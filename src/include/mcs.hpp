@@ -0,0 +1,113 @@
+#pragma once
+#include "aco.hpp"
+#include "anytime.hpp"
+#include "graph.hpp"
+#include "islands.hpp"
+#include "mapping.hpp"
+#include "telemetry.hpp"
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file mcs.hpp
+ * @brief API de la biblioteca libmcs (lo que usa el ejecutable mcs_aco).
+ *
+ * Uso mínimo, sin archivos:
+ *
+ *     mcs::EdgeArray a{n1, src1, dst1, m1}, b{n2, src2, dst2, m2};
+ *     mcs::SolveOptions opts;
+ *     opts.aco.seed = 7;
+ *     opts.progress = [&](const mcs::ACOProgress& p) { return !stop_requested; };
+ *     mcs::SolveResult r = mcs::solve(a, b, opts);
+ *
+ * Con plazo: opts.cancel = &token y opts.anytime = &best; desde otro hilo,
+ * token.cancel() detiene la búsqueda y best.get() da la mejor solución
+ * publicada hasta ese momento.
+ *
+ * solve() no escribe nada en la salida estándar salvo que se pida con
+ * opts.aco.verbose.
+ */
+namespace mcs {
+
+/**
+ * @brief Motor de búsqueda: ACO, exacto (McSplit) o ACO seguido del exacto.
+ */
+enum class Solver { Aco, Exact, Hybrid };
+
+/**
+ * @brief Gráfica no dirigida en memoria como arreglos de aristas.
+ *
+ * La arista i es (sources[i], targets[i]), con vértices en [0, num_vertices).
+ * Las repetidas se ignoran; los arreglos solo se leen durante make_graph.
+ */
+struct EdgeArray {
+    std::size_t num_vertices = 0;
+    const Graph::Vertex* sources = nullptr;
+    const Graph::Vertex* targets = nullptr;
+    std::size_t num_edges = 0;
+};
+
+/**
+ * @brief Opciones de solve().
+ *
+ * - solver: motor de búsqueda.
+ * - aco: parámetros del ACO; time_limit y num_threads también se aplican al
+ *   exacto. A diferencia de ACOParams, verbose empieza en false.
+ * - use_islands / islands: modelo de islas en lugar de una sola colonia.
+ * - progress: se llama entre iteraciones del ACO; si devuelve false la
+ *   búsqueda termina con la mejor solución hasta ese momento y, en modo
+ *   hybrid, el exacto ya no se ejecuta.
+ * - telemetry: sink de estadísticas por iteración (no se adueña).
+ * - cancel: token que otro hilo puede activar (por ejemplo al vencer un
+ *   plazo); el ACO lo revisa antes de cada hormiga y el exacto junto con su
+ *   límite de tiempo. solve() regresa enseguida con lo mejor encontrado.
+ * - anytime: recibe cada mejora como instantánea inmutable; otro hilo la
+ *   lee con anytime->get() mientras solve() sigue corriendo.
+ */
+struct SolveOptions {
+    Solver solver = Solver::Aco;
+    ACOParams aco;
+    bool use_islands = false;
+    IslandParams islands;
+    ProgressCallback progress;
+    TelemetryWriter* telemetry = nullptr;
+    const CancellationToken* cancel = nullptr;
+    AnytimeBest* anytime = nullptr;
+
+    SolveOptions() { aco.verbose = false; }
+};
+
+/**
+ * @brief Resultado de solve().
+ *
+ * - mapping: pares (vértice de g1, vértice de g2) de la subgráfica común.
+ * - size / edges: vértices y aristas de la subgráfica.
+ * - iterations: iteraciones del ACO (por isla); 0 con el exacto solo.
+ * - exact_nodes: nodos visitados por el exacto; 0 sin exacto.
+ * - optimal: el exacto probó optimalidad o se alcanzó la cota min(n1, n2).
+ * - cancelled: el callback de progreso o el token detuvieron la búsqueda.
+ * - seconds: tiempo total de la búsqueda (sin construir las gráficas).
+ */
+struct SolveResult {
+    Mapping mapping;
+    int size = 0;
+    int edges = 0;
+    int iterations = 0;
+    std::uint64_t exact_nodes = 0;
+    bool optimal = false;
+    bool cancelled = false;
+    double seconds = 0.0;
+};
+
+/// Construye una gráfica a partir de arreglos de aristas (lanza std::invalid_argument si hay ids fuera de rango).
+Graph make_graph(const EdgeArray& edges, GraphStorage storage = GraphStorage::Auto);
+
+/// MCIS entre dos gráficas ya construidas.
+SolveResult solve(const Graph& g1, const Graph& g2, const SolveOptions& options = {});
+
+/// MCIS entre dos gráficas en memoria.
+SolveResult solve(const EdgeArray& g1, const EdgeArray& g2,
+                  const SolveOptions& options = {},
+                  GraphStorage storage = GraphStorage::Auto);
+
+} // namespace mcs
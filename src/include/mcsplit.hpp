@@ -0,0 +1,151 @@
+#pragma once
+#include "anytime.hpp"
+#include "graph.hpp"
+#include "mapping.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace mcs {
+
+/**
+ * @brief Solver exacto del MCIS por ramificación y acotamiento (McSplit).
+ *
+ * Los vértices aún libres se agrupan en clases (bidominios): dos vértices
+ * quedan en la misma clase cuando tienen la misma relación de adyacencia con
+ * todos los vértices ya emparejados. Solo se pueden emparejar vértices de la
+ * misma clase, así que
+ *
+ *     |M| + Σ min(|clase en G1|, |clase en G2|)
+ *
+ * es una cota superior de cualquier mapeo que extienda al actual.
+ *
+ * Cada clase es un rango contiguo de left / right, que se reordenan en su
+ * lugar al refinar; las listas de clases viven en una pila por profundidad
+ * que se reutiliza, por lo que la búsqueda no asigna memoria una vez que
+ * cada nivel alcanzó su tamaño.
+ *
+ * No se usan dominios de bits (un conjunto de n / 64 palabras por clase):
+ * las clases son disjuntas y suman a lo más n1 + n2 vértices, así que
+ * refinar todos los rangos cuesta O(n) por nodo, mientras que con bits cada
+ * clase costaría O(n / 64) palabras aunque tenga un solo vértice, y hay hasta
+ * min(n1, n2) clases. Los bits sí se usan donde rinden: la prueba de
+ * adyacencia de cada vértice contra el recién emparejado es Graph::edge,
+ * que en almacenamiento denso lee la fila de bits.
+ *
+ * Con varios hilos, los primeros SPLIT_DEPTH niveles del árbol se reparten
+ * como tareas de OpenMP (que los hilos ociosos roban de la cola); debajo de
+ * ese nivel cada hilo sigue con su propio estado. El tamaño del mejor mapeo
+ * se comparte con un entero atómico, así que una mejora poda de inmediato
+ * en todos los hilos.
+ */
+class McSplit {
+public:
+    McSplit(const Graph& g1, const Graph& g2);
+
+    /// Solución inicial (por ejemplo la del ACO): se poda todo lo que no la supere.
+    void set_incumbent(const Mapping& mapping);
+
+    /// Tiempo máximo de búsqueda en segundos (0 = sin límite).
+    void set_time_limit(double seconds) { time_limit_ = seconds; }
+
+    /// Token revisado junto con el límite de tiempo; cancelar equivale a agotarlo.
+    void set_cancellation(const CancellationToken* token) { cancel_ = token; }
+
+    /// Hilos de la búsqueda (0 = los de OpenMP por defecto).
+    void set_threads(int threads) { threads_ = threads; }
+
+    /// Ejecuta la búsqueda y devuelve el mejor mapeo encontrado.
+    Mapping solve();
+
+    /// true si la última búsqueda terminó sin agotar el tiempo ni cancelarse (óptimo probado).
+    bool is_optimal() const { return optimal_; }
+
+    /// Nodos del árbol de búsqueda visitados en la última búsqueda.
+    std::uint64_t nodes() const { return nodes_; }
+
+private:
+    /// Clase de vértices: left[l, l + left_len) × right[r, r + right_len).
+    struct Bidomain {
+        int l, r;
+        int left_len, right_len;
+    };
+
+    using Pair = std::pair<int, int>;
+
+    /// Estado de búsqueda de un hilo; se reutiliza entre subárboles.
+    struct Worker {
+        std::vector<int> left, right;
+        std::vector<std::vector<Bidomain>> domains;  // una lista por profundidad
+        std::vector<Pair> current;                    // en rangos
+        std::uint64_t nodes = 0;
+    };
+
+    /// Nodo de los primeros niveles, con copia propia del estado (una tarea).
+    struct Subproblem {
+        std::vector<int> left, right;
+        std::vector<Bidomain> domains;
+        std::vector<Pair> current;
+        std::size_t depth = 0;
+    };
+
+    // Profundidad hasta la que los nodos se reparten como tareas
+    static constexpr std::size_t SPLIT_DEPTH = 2;
+
+    const Graph& g1_;
+    const Graph& g2_;
+
+    // Los vértices se renumeran por grado descendente: rango -> vértice original
+    std::vector<Vertex> order1_, order2_;
+
+    std::vector<Worker> workers_;
+
+    // Mejor mapeo (en rangos); incumbent_ se protege con incumbent_mutex_ y su
+    // tamaño se publica en incumbent_size_ para podar sin bloqueo
+    std::vector<Pair> incumbent_;
+    std::mutex incumbent_mutex_;
+    std::atomic<int> incumbent_size_{0};
+
+    double time_limit_ = 0.0;
+    const CancellationToken* cancel_ = nullptr;
+    int threads_ = 0;
+    bool optimal_ = false;
+    std::atomic<bool> timed_out_{false};
+    std::uint64_t nodes_ = 0;
+    std::chrono::steady_clock::time_point start_;
+
+    // Búsqueda secuencial desde el nivel `depth` de w
+    void search(Worker& w, std::size_t depth);
+
+    // Nodo de los primeros niveles: cada rama se lanza como tarea
+    void expand(Subproblem& node);
+
+    // Resuelve un subproblema con el estado w (el del hilo que lo ejecuta)
+    void run_subproblem(const Subproblem& node, Worker& w);
+
+    // Un nodo completo: poda, elige v, llama branch(v, w) para cada w de su
+    // clase y repite con v sin pareja. nodes cuenta los nodos visitados.
+    template <class Branch>
+    void branch_loop(std::vector<Bidomain>& domains, std::vector<int>& left,
+                     std::vector<int>& right, const std::vector<Pair>& current,
+                     std::uint64_t& nodes, Branch&& branch);
+
+    void offer(const std::vector<Pair>& current);
+
+    static int bound(const std::vector<Bidomain>& domains);
+    static int select_bidomain(const std::vector<Bidomain>& domains,
+                               const std::vector<int>& left);
+
+    // Refina `in` respecto a la nueva pareja (v, w) y escribe las clases en `out`
+    void filter_domains(const std::vector<Bidomain>& in,
+                        std::vector<Bidomain>& out,
+                        std::vector<int>& left, std::vector<int>& right,
+                        int v, int w) const;
+
+    bool out_of_time(std::uint64_t nodes);
+};
+
+} // namespace mcs
@@ -1,29 +1,148 @@
 #pragma once
 #include "graph.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
 #include <vector>
 
 namespace mcs {
 
+/// Tipo de almacenamiento de las feromonas (float32 con -Dpheromone_float=true).
+#ifdef MCS_PHEROMONE_FLOAT
+using Tau = float;
+#else
+using Tau = double;
+#endif
+
+/**
+ * @brief Almacenamiento de la matriz de feromonas.
+ *
+ * - Dense: arreglo n1 × n2.
+ * - Sparse: tabla hash abierta que solo guarda los pares que recibieron
+ *   depósito; el resto vale el valor por defecto (que también se evapora).
+ * - Auto: Sparse cuando la matriz densa pasaría de 256 MiB.
+ */
+enum class PheromoneStorage { Dense, Sparse, Auto };
+
+/**
+ * @brief Matriz de feromonas n1 × n2 (densa o dispersa).
+ *
+ * Con evaporación perezosa (por defecto) el valor real es raw · scale_:
+ * evaporar solo multiplica scale_ (O(1)) y depositar divide entre scale_.
+ * Cuando scale_ se vuelve muy pequeño se renormaliza con un barrido completo,
+ * el mismo que usa la evaporación inmediata (vectorizado con AVX2/AVX-512
+ * si el compilador los habilita, escalar si no).
+ *
+ * Con set_bounds (MAX-MIN Ant System) los valores se acotan a
+ * [tau_min, tau_max] al leer y al depositar, sin barrer la matriz: lo
+ * almacenado puede evaporarse por debajo de tau_min, pero get() nunca lo
+ * devuelve.
+ */
 class PheromoneMatrix {
 public:
-    PheromoneMatrix(std::size_t n1, std::size_t n2, double init_value = 1.0);
+    PheromoneMatrix(std::size_t n1, std::size_t n2, double init_value = 1.0,
+                    bool lazy = true,
+                    PheromoneStorage storage = PheromoneStorage::Dense);
+
+    double get(Vertex u, Vertex v) const {
+        const Tau raw = dense_ ? pheromone_[index(u, v)] : sparse_get(index(u, v));
+        return clamp(static_cast<double>(raw) * scale_);
+    }
 
-    double get(Vertex u, Vertex v) const;
     void set(Vertex u, Vertex v, double value);
-    void deposit(Vertex u, Vertex v, double amount);
+
+    void deposit(Vertex u, Vertex v, double amount) {
+        Tau& slot = dense_ ? pheromone_[index(u, v)] : sparse_slot(index(u, v));
+        if (bounded_) {
+            const double value = clamp(clamp(slot * scale_) + amount);
+            slot = static_cast<Tau>(value * inv_scale_);
+        } else {
+            slot += static_cast<Tau>(amount * inv_scale_);
+        }
+    }
+
+    /// Límites MAX-MIN; (0, ∞) los desactiva.
+    void set_bounds(double tau_min, double tau_max);
+    double tau_min() const { return tau_min_; }
+    double tau_max() const { return tau_max_; }
+
+    /**
+     * @brief Factor de convergencia de MMAS en [0, 1].
+     *
+     * 0 cuando todo vale lo mismo entre los límites y 1 cuando cada entrada
+     * está en tau_min o en tau_max (la colonia ya no explora). Recorre la
+     * matriz completa; sin límites devuelve 0.
+     */
+    double convergence_factor() const;
+
+    /**
+     * @brief Entropía de Shannon de la distribución τ / Σ τ, normalizada a [0, 1].
+     *
+     * 1 cuando todas las entradas valen lo mismo; baja conforme las feromonas
+     * se concentran en pocos pares. Recorre la matriz completa (las entradas
+     * implícitas del modo disperso se suman de una vez).
+     */
+    double entropy() const;
+
     void evaporate(double rho);
     void reset(double value = 1.0);
 
+    /// τ ← (1 - weight) · τ + weight · τ_other, entrada por entrada (mismas dimensiones).
+    void blend(const PheromoneMatrix& other, double weight);
+
     std::size_t size_g1() const { return n1_; }
     std::size_t size_g2() const { return n2_; }
+    bool is_lazy() const { return lazy_; }
+    bool is_dense() const { return dense_; }
+
+    /// Entradas almacenadas explícitamente (n1·n2 en modo denso).
+    std::size_t stored_entries() const {
+        return dense_ ? pheromone_.size() : sparse_count_;
+    }
 
 private:
     std::size_t n1_, n2_;
-    std::vector<double> pheromone_;
+    bool dense_;
+    std::vector<Tau> pheromone_;
+
+    // Tabla hash abierta (sondeo lineal) para el modo disperso
+    static constexpr std::uint64_t EMPTY_KEY = ~std::uint64_t{0};
+    std::vector<std::uint64_t> sparse_keys_;
+    std::vector<Tau> sparse_values_;
+    std::size_t sparse_count_ = 0;
+    Tau default_raw_;
+
+    Tau sparse_get(std::uint64_t key) const;
+    bool sparse_contains(std::uint64_t key) const;
+
+    // Referencia al valor de key; lo crea con default_raw_ si no existe
+    Tau& sparse_slot(std::uint64_t key);
+    void sparse_grow();
+
+    bool lazy_;
+    double scale_ = 1.0;
+    double inv_scale_ = 1.0;
+
+    bool bounded_ = false;
+    double tau_min_ = 0.0;
+    double tau_max_ = std::numeric_limits<double>::infinity();
+
+    double clamp(double value) const {
+        return std::min(std::max(value, tau_min_), tau_max_);
+    }
+
+    // Multiplica todas las entradas (y el valor por defecto) por factor
+    void scale_all(double factor);
+
+    // Barrido vectorizado data[i] *= factor
+    static void scale_array(Tau* data, std::size_t n, double factor);
+
+    // Incorpora scale_ a los valores almacenados y lo regresa a 1
+    void renormalize();
 
     inline std::size_t index(Vertex u, Vertex v) const {
-        return u * n2_ + v;
+        return static_cast<std::size_t>(u) * n2_ + v;
     }
 };
 
-} // namespace mcs
\ No newline at end of file
+} // namespace mcs
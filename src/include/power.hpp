@@ -0,0 +1,35 @@
+#pragma once
+#include <cstddef>
+
+namespace mcs {
+
+/**
+ * @brief Evaluación especializada de x^e sobre arreglos completos.
+ *
+ * El exponente se resuelve una sola vez al construir el objeto:
+ * - enteros pequeños (0..8, como los alpha = 1 y beta = 3 por defecto) se
+ *   convierten en cadenas fijas de multiplicaciones;
+ * - cualquier otro valor usa exp(e · log(x)) con polinomios propios, sin
+ *   llamadas a libm, escritos para que el compilador vectorice el ciclo.
+ *
+ * Los valores de entrada deben ser positivos y finitos.
+ */
+class PowerKernel {
+public:
+    explicit PowerKernel(double exponent = 1.0);
+
+    /// Reemplaza cada x[i] por x[i]^exponent.
+    void apply(double* x, std::size_t count) const;
+
+    double exponent() const { return exponent_; }
+    bool is_integral() const { return kind_ != Kind::General; }
+
+private:
+    enum class Kind { Zero, One, Square, Cube, Integer, General };
+
+    double exponent_;
+    Kind kind_;
+    unsigned n_;  // exponente entero (Kind::Integer)
+};
+
+} // namespace mcs
@@ -0,0 +1,117 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace mcs {
+
+/**
+ * @brief Instrumentación de las rutas críticas (contadores y tiempos).
+ *
+ * Solo existe si se compila con MCS_PROFILE (meson configure -Dprofile=true);
+ * sin él las macros MCS_PROFILE_* no generan código. Cada hilo acumula en su
+ * propia ranura (sin atómicos ni candados en la ruta crítica) y el reporte
+ * suma las ranuras al final, cuando ya no hay regiones paralelas activas.
+ *
+ * Los tiempos por fase son de pared y se suman entre hilos cuando la fase
+ * corre en varios a la vez (construcción de las islas, muestreo de cada
+ * hormiga). Por hilo se mide el tiempo ocupado (construyendo hormigas) y el
+ * tiempo dentro del equipo de OpenMP; la diferencia es espera en la barrera.
+ */
+namespace profile {
+
+enum class Counter {
+    SampleAttempts,     // pares sorteados al llenar el pool
+    SampleAccepted,     // pares que entraron al pool
+    FeasibilityChecks,  // llamadas a Mapping::is_feasible_add
+    HeuristicEvals,     // llamadas a Ant::compute_heuristic
+    PairSelections,     // llamadas a Ant::select_next_pair
+    Solutions,          // soluciones construidas
+    Count
+};
+
+enum class Phase {
+    Read,             // Reader::read_graph
+    Construction,     // construcción paralela de una iteración
+    Sampling,         // llenado del pool de candidatos
+    Selection,        // select_next_pair completo (incluye el muestreo)
+    LocalSearch,
+    PheromoneUpdate,  // evaporación, límites MMAS, depósitos y reinicios
+    Export,           // archivo .mcis
+    Svg,
+    Count
+};
+
+/// true si el binario se compiló con instrumentación.
+constexpr bool enabled() {
+#ifdef MCS_PROFILE
+    return true;
+#else
+    return false;
+#endif
+}
+
+void add(Counter counter, std::uint64_t amount);
+void add_time(Phase phase, double seconds);
+void add_busy(double seconds);
+void add_team(double seconds);
+
+/// Reporte legible de todas las ranuras.
+void print_report(std::ostream& out);
+
+/// El mismo reporte en JSON (lanza std::runtime_error si no se puede escribir).
+void write_json(const std::string& path);
+
+using Clock = std::chrono::steady_clock;
+
+/// Suma a una fase el tiempo de vida del objeto.
+class ScopedPhase {
+public:
+    explicit ScopedPhase(Phase phase) : phase_(phase), start_(Clock::now()) {}
+    ~ScopedPhase() {
+        add_time(phase_, std::chrono::duration<double>(Clock::now() - start_).count());
+    }
+
+private:
+    Phase phase_;
+    Clock::time_point start_;
+};
+
+/// Tiempo ocupado (busy = true) o dentro del equipo de OpenMP del hilo actual.
+class ScopedThreadTime {
+public:
+    explicit ScopedThreadTime(bool busy) : busy_(busy), start_(Clock::now()) {}
+    ~ScopedThreadTime() {
+        const double s = std::chrono::duration<double>(Clock::now() - start_).count();
+        busy_ ? add_busy(s) : add_team(s);
+    }
+
+private:
+    bool busy_;
+    Clock::time_point start_;
+};
+
+} // namespace profile
+} // namespace mcs
+
+#ifdef MCS_PROFILE
+#define MCS_PROFILE_CONCAT_(a, b) a##b
+#define MCS_PROFILE_CONCAT(a, b) MCS_PROFILE_CONCAT_(a, b)
+#define MCS_PROFILE_ADD(counter, amount) \
+    ::mcs::profile::add(::mcs::profile::Counter::counter, (amount))
+#define MCS_PROFILE_COUNT(counter) MCS_PROFILE_ADD(counter, 1)
+#define MCS_PROFILE_PHASE(phase) \
+    const ::mcs::profile::ScopedPhase MCS_PROFILE_CONCAT(mcs_profile_, __LINE__)( \
+        ::mcs::profile::Phase::phase)
+#define MCS_PROFILE_BUSY() \
+    const ::mcs::profile::ScopedThreadTime MCS_PROFILE_CONCAT(mcs_profile_, __LINE__)(true)
+#define MCS_PROFILE_TEAM() \
+    const ::mcs::profile::ScopedThreadTime MCS_PROFILE_CONCAT(mcs_profile_, __LINE__)(false)
+#else
+#define MCS_PROFILE_ADD(counter, amount) ((void)0)
+#define MCS_PROFILE_COUNT(counter) ((void)0)
+#define MCS_PROFILE_PHASE(phase) ((void)0)
+#define MCS_PROFILE_BUSY() ((void)0)
+#define MCS_PROFILE_TEAM() ((void)0)
+#endif
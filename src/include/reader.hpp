@@ -1,30 +1,55 @@
 #pragma once
 
+#include "graph.hpp"
 #include <string>
-#include <unordered_map>
+#include <string_view>
 #include <vector>
-#include <fstream>
-#include <sstream>
 
 namespace mcs {
 
-class Graph;
-
+/**
+ * @brief Lector de listas de aristas.
+ *
+ * Formato: una arista "u v" por línea (los tokens extra se ignoran y se quita
+ * un ';' final de v); se omiten las líneas vacías y las que empiezan con '#'.
+ * Los identificadores se asignan en orden de primera aparición.
+ *
+ * El archivo se mapea en memoria y se separa en tokens sin copiarlo: cada
+ * nombre se guarda una sola vez en una tabla hash cuyas claves son vistas al
+ * propio archivo, y las aristas salen directamente como pares de enteros.
+ * Los archivos grandes se dividen en bloques que se procesan en paralelo.
+ *
+ * Si junto al archivo existe un caché binario vigente ("<archivo>.mcsg", ver
+ * graph_cache.hpp) se usa ese en lugar del texto; también se puede pasar el
+ * .mcsg directamente.
+ */
 class Reader {
 public:
-    Graph read_graph(const std::string& filename);
+    /**
+     * @brief Lee una lista de aristas y construye la gráfica.
+     *
+     * @param storage Almacenamiento de la adyacencia (Auto elige CSR para
+     *                gráficas grandes y dispersas).
+     */
+    Graph read_graph(const std::string& filename,
+                     GraphStorage storage = GraphStorage::Auto);
+
+    /// Igual que read_graph, pero sobre un texto ya cargado en memoria.
+    Graph parse_graph(std::string_view text,
+                      GraphStorage storage = GraphStorage::Auto);
 
     const std::vector<std::string>& id_to_name() const { return id_to_name_; }
 
-private:
-    int get_or_create_id(const std::string& name);
+    /// Escribir "<archivo>.mcsg" cada vez que se lea el texto.
+    void set_write_cache(bool write) { write_cache_ = write; }
 
-    bool parse_edge_line(const std::string& line,
-                         std::string& u,
-                         std::string& v) const;
+    /// true si la última gráfica salió de un caché .mcsg.
+    bool loaded_from_cache() const { return from_cache_; }
 
-    std::unordered_map<std::string, int> name_to_id_;
+private:
     std::vector<std::string> id_to_name_;
+    bool write_cache_ = false;
+    bool from_cache_ = false;
 };
 
 } // namespace mcs
@@ -0,0 +1,87 @@
+#pragma once
+#include "buffered_writer.hpp"
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace mcs {
+
+/**
+ * @brief Estadísticas de una iteración de una colonia.
+ *
+ * mean_score y max_score son sobre las hormigas de la iteración (tras la
+ * búsqueda local); entropy es la entropía normalizada de las feromonas en
+ * [0, 1] (1 = uniforme, cerca de 0 = la colonia convergió). Calcularla
+ * recorre toda la matriz, así que la colonia la actualiza cada 25
+ * iteraciones y las intermedias repiten el último valor.
+ */
+struct IterationStats {
+    int colony = 0;
+    int iteration = 0;
+    int best_size = 0;
+    int best_edges = 0;
+    double mean_score = 0.0;
+    int max_score = 0;
+    double entropy = 0.0;
+    double seconds = 0.0;
+};
+
+/// CSV con encabezado o un objeto JSON por línea (NDJSON).
+enum class TelemetryFormat { Csv, Ndjson };
+
+/**
+ * @brief Telemetría por iteración escrita por un hilo propio.
+ *
+ * push() solo copia el registro a un anillo preasignado bajo un candado
+ * corto; un hilo de fondo pasa el anillo a un BufferedWriter y lo lleva
+ * al archivo (sync) tras cada lote, así que el ciclo del solver nunca espera
+ * E/S. Si el anillo está lleno el registro se descarta y se cuenta.
+ * Admite varios productores (las islas corren en paralelo).
+ */
+class TelemetryWriter {
+public:
+    static constexpr std::size_t DEFAULT_CAPACITY = 4096;
+
+    /// Abre el archivo y arranca el hilo escritor; lanza si no se puede crear.
+    TelemetryWriter(const std::string& path, TelemetryFormat format,
+                    std::size_t capacity = DEFAULT_CAPACITY);
+    ~TelemetryWriter();
+
+    TelemetryWriter(const TelemetryWriter&) = delete;
+    TelemetryWriter& operator=(const TelemetryWriter&) = delete;
+
+    /// Formato según la extensión: .csv → Csv, cualquier otra → Ndjson.
+    static TelemetryFormat format_for(const std::string& path);
+
+    void push(const IterationStats& stats);
+
+    /// Escribe lo pendiente, detiene el hilo y cierra; false si hubo error de E/S.
+    bool close();
+
+    /// Registros descartados por anillo lleno.
+    std::uint64_t dropped() const;
+
+private:
+    BufferedWriter out_;
+    TelemetryFormat format_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable ready_;
+    std::vector<IterationStats> ring_;
+    std::size_t head_ = 0;
+    std::size_t count_ = 0;
+    std::uint64_t dropped_ = 0;
+    bool stop_ = false;
+    bool closed_ = false;
+    bool ok_ = true;
+
+    std::thread worker_;
+
+    void run();
+    void write(const IterationStats& s);
+};
+
+} // namespace mcs
@@ -2,10 +2,14 @@
 #include "../include/ant.hpp"
 #include "../include/mapping.hpp"
 #include "../include/pheromone.hpp"
+#include "../include/profile.hpp"
 #include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <iomanip>
 #include <iostream>
-#include <random>
+#include <limits>
+#include <memory>
 #include <vector>
 
 #ifdef _OPENMP
@@ -14,102 +18,342 @@
 
 namespace mcs {
 
+// MMAS: cada cuántas iteraciones se calcula el factor de convergencia
+static constexpr int CONVERGENCE_CHECK_INTERVAL = 25;
+
+// MMAS: iteraciones sin mejora necesarias para reiniciar
+static constexpr int RESTART_STAGNATION = 50;
+
+// Telemetría: cada cuántas iteraciones se recalcula la entropía (recorre la
+// matriz de feromonas); las demás repiten el último valor
+static constexpr int TELEMETRY_ENTROPY_INTERVAL = 25;
+
+// Iteraciones del historial de convergencia que se reservan de antemano
+static constexpr int MAX_HISTORY_RESERVE = 1 << 16;
+
+// MMAS: probabilidad de que la mejor hormiga reconstruya la mejor solución
+// cuando la colonia convergió (determina tau_min)
+static constexpr double MMAS_P_BEST = 0.05;
+
+static int max_threads(int requested) {
+    if (requested > 0) return requested;
+#ifdef _OPENMP
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
+static int thread_id() {
+#ifdef _OPENMP
+    return omp_get_thread_num();
+#else
+    return 0;
+#endif
+}
+
 ACO::ACO(const Graph& g1, const Graph& g2, const ACOParams& params)
     : g1_(g1),
       g2_(g2),
       params_(params),
-      pheromone_(g1.num_vertices(), g2.num_vertices(), 1.0),
+      pheromone_(g1.num_vertices(), g2.num_vertices(), 1.0,
+                 params.lazy_evaporation, params.pheromone_storage),
       rng_(params.seed),
       best_score_(0),
-      best_edges_(0) {}
+      best_edges_(0),
+      workers_(static_cast<std::size_t>(max_threads(params.num_threads))),
+      scores_(params.num_ants, 0),
+      edges_(params.num_ants, 0) {
+    solutions_.reserve(params.num_ants);
+    for (int k = 0; k < params.num_ants; ++k) {
+        solutions_.emplace_back(g1.num_vertices(), g2.num_vertices());
+    }
+    best_solution_.reset(g1.num_vertices(), g2.num_vertices());
+    convergence_history_.reserve(static_cast<std::size_t>(
+        std::clamp(params.max_iterations, 0, MAX_HISTORY_RESERVE)));
+
+    if (params.local_search != LocalSearchMode::None) {
+        searchers_.reserve(workers_.size());
+        for (std::size_t t = 0; t < workers_.size(); ++t) {
+            searchers_.emplace_back(g1, g2);
+        }
+    }
+}
 
 Mapping ACO::solve() {
-    std::cout << "ACO (MCIS inducido)\n";
-    std::cout << "G1 vertices: " << g1_.num_vertices() << "\n";
-    std::cout << "G2 vertices: " << g2_.num_vertices() << "\n";
-    std::cout << "Hormigas: " << params_.num_ants << "\n";
-    std::cout << "Iteraciones: " << params_.max_iterations << "\n\n";
+    if (params_.verbose) {
+        std::cout << "ACO (MCIS inducido)\n";
+        std::cout << "G1 vertices: " << g1_.num_vertices() << "\n";
+        std::cout << "G2 vertices: " << g2_.num_vertices() << "\n";
+        std::cout << "Hormigas: " << params_.num_ants << "\n";
+        std::cout << "Iteraciones: " << params_.max_iterations << "\n\n";
+    }
+
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point start = Clock::now();
+    const int bound = upper_bound();
+    const char* stop_reason = "iteraciones";
+    int stagnation = 0;
 
+    iterations_run_ = 0;
+    restarts_ = 0;
+    last_improvement_ = 0;
+    convergence_history_.clear();
+    cancelled_ = false;
     for (int iter = 0; iter < params_.max_iterations; ++iter) {
-        run_iteration(iter);
+        stagnation = step() ? 0 : stagnation + 1;
+
+        if (cancel_requested()) {
+            cancelled_ = true;
+            stop_reason = "cancelado";
+            break;
+        }
+
+        if (progress_) {
+            const std::chrono::duration<double> elapsed = Clock::now() - start;
+            if (!progress_({iterations_run_, best_score_, best_edges_, elapsed.count()})) {
+                cancelled_ = true;
+                stop_reason = "cancelado";
+                break;
+            }
+        }
+
+        // Criterios de parada (entre iteraciones)
+        if (best_score_ >= bound) {
+            stop_reason = "cota superior alcanzada (óptimo)";
+            break;
+        }
+        if (params_.target_size > 0 && best_score_ >= params_.target_size) {
+            stop_reason = "tamaño objetivo alcanzado";
+            break;
+        }
+        if (params_.max_stagnation > 0 && stagnation >= params_.max_stagnation) {
+            stop_reason = "estancamiento";
+            break;
+        }
+        if (params_.time_limit > 0.0) {
+            const std::chrono::duration<double> elapsed = Clock::now() - start;
+            if (elapsed.count() >= params_.time_limit) {
+                stop_reason = "límite de tiempo";
+                break;
+            }
+        }
     }
 
-    std::cout << "\nFinal: " << best_score_ << " vertices, " << best_edges_
-              << " edges\n";
+    if (params_.verbose) {
+        if (params_.mmas) std::cout << "Reinicios MMAS: " << restarts_ << "\n";
+        std::cout << "Parada: " << stop_reason << " tras " << iterations_run_
+                  << " iteraciones\n";
+        std::cout << "\nFinal: " << best_score_ << " vertices, " << best_edges_
+                  << " edges\n";
+    }
     return best_solution_;
 }
 
-void ACO::run_iteration(int iter) {
-    std::vector<Mapping> solutions(params_.num_ants);
-    std::vector<int> scores(params_.num_ants, 0);
+bool ACO::step() {
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point start = Clock::now();
+    const bool improved = run_iteration(iterations_run_);
+    convergence_history_.push_back(best_score_);
+    if (telemetry_) {
+        const std::chrono::duration<double> elapsed = Clock::now() - start;
+        record_telemetry(iterations_run_, elapsed.count());
+    }
+    ++iterations_run_;
+    return improved;
+}
 
-    int local_best_score = 0;
-    int local_best_edges = 0;
-    Mapping local_best_solution;
+void ACO::publish_best(int iter) {
+    if (!anytime_) return;
+    auto snapshot = std::make_shared<SolutionSnapshot>();
+    snapshot->mapping = best_solution_;
+    snapshot->size = best_score_;
+    snapshot->edges = best_edges_;
+    snapshot->iteration = iter;
+    anytime_->offer(std::move(snapshot));
+}
 
-    #pragma omp parallel
-    {
-        int thread_best_score = 0;
-        int thread_best_edges = 0;
-        Mapping thread_best_solution;
+void ACO::record_telemetry(int iter, double seconds) {
+    IterationStats stats;
+    stats.colony = colony_;
+    stats.iteration = iter;
+    stats.best_size = best_score_;
+    stats.best_edges = best_edges_;
+    long long total = 0;
+    int built = 0;
+    for (const int score : scores_) {
+        if (score < 0) continue;  // sin construir (cancelada)
+        total += score;
+        ++built;
+        stats.max_score = std::max(stats.max_score, score);
+    }
+    stats.mean_score = built > 0 ? static_cast<double>(total) / built : 0.0;
+    if (iter % TELEMETRY_ENTROPY_INTERVAL == 0) telemetry_entropy_ = pheromone_.entropy();
+    stats.entropy = telemetry_entropy_;
+    stats.seconds = seconds;
+    telemetry_->push(stats);
+}
 
-        #pragma omp for schedule(static)
-        for (int k = 0; k < params_.num_ants; ++k) {
-            unsigned seed =
-                static_cast<unsigned>(params_.seed) ^
-                static_cast<unsigned>(iter * 1315423911u) ^
-                static_cast<unsigned>(k * 2654435761u);
+bool ACO::accept_migrant(const Mapping& migrant) {
+    const int score = migrant.size();
+    const int edges = migrant.count_edges(g1_, g2_);
+    if (score < best_score_ || (score == best_score_ && edges <= best_edges_)) {
+        return false;
+    }
 
-#ifdef _OPENMP
-            seed ^= static_cast<unsigned>(omp_get_thread_num() * 97531u);
-#endif
+    best_solution_ = migrant;
+    best_score_ = score;
+    best_edges_ = edges;
+    last_improvement_ = iterations_run_;
 
-            std::mt19937 local_rng(seed);
-            Ant ant(local_rng);
+    // Mismo refuerzo que recibe la mejor solución propia
+    const double delta =
+        params_.mmas ? score / static_cast<double>(upper_bound()) : 5.0;
+    for (const auto& [u, v] : best_solution_.pairs()) {
+        pheromone_.deposit(u, v, delta);
+    }
+    return true;
+}
+
+int ACO::upper_bound() const {
+    return static_cast<int>(std::min(g1_.num_vertices(), g2_.num_vertices()));
+}
 
-            Mapping sol = ant.construct_solution(
-                g1_, g2_, pheromone_, params_.alpha, params_.beta
-            );
+bool ACO::run_iteration(int iter) {
+    std::vector<Mapping>& solutions = solutions_;
+    std::vector<int>& scores = scores_;
+    std::vector<int>& edges = edges_;
 
-            const int score = static_cast<int>(sol.size());
-            const int edges = sol.count_edges(g1_, g2_);
+    {
+        MCS_PROFILE_PHASE(Construction);
+        // Región y reparto separados para medir, por hilo, la espera en la barrera
+        #pragma omp parallel num_threads(static_cast<int>(workers_.size()))
+        {
+            MCS_PROFILE_TEAM();
+            #pragma omp for schedule(static)
+            for (int k = 0; k < params_.num_ants; ++k) {
+                if (cancel_requested()) {
+                    // Hormiga sin construir: no compite en la reducción
+                    scores[k] = -1;
+                    edges[k] = -1;
+                    continue;
+                }
+                MCS_PROFILE_BUSY();
+                // Flujo aleatorio propio de (semilla, iteración, hormiga)
+                Ant& ant = workers_[thread_id()];
+                ant.reseed(stream_seed(static_cast<std::uint64_t>(params_.seed),
+                                       static_cast<std::uint64_t>(iter),
+                                       static_cast<std::uint64_t>(k)));
 
-            solutions[k] = sol;
-            scores[k] = score;
+                ant.construct_solution(g1_, g2_, pheromone_, params_.alpha,
+                                       params_.beta, solutions[k]);
+                MCS_PROFILE_COUNT(Solutions);
+                if (params_.local_search == LocalSearchMode::All) {
+                    MCS_PROFILE_PHASE(LocalSearch);
+                    searchers_[thread_id()].improve(solutions[k],
+                                                    params_.local_search_steps);
+                }
 
-            if (score > thread_best_score ||
-                (score == thread_best_score && edges > thread_best_edges)) {
-                thread_best_score = score;
-                thread_best_edges = edges;
-                thread_best_solution = sol;
+                scores[k] = static_cast<int>(solutions[k].size());
+                edges[k] = solutions[k].count_edges(g1_, g2_);
             }
         }
+    }
 
-        #pragma omp critical
-        {
-            if (thread_best_score > local_best_score ||
-                (thread_best_score == local_best_score &&
-                 thread_best_edges > local_best_edges)) {
-                local_best_score = thread_best_score;
-                local_best_edges = thread_best_edges;
-                local_best_solution = thread_best_solution;
-            }
+    // Reducción en orden de hormiga: los empates los gana el índice menor,
+    // sin importar qué hilo terminó primero
+    int local_best = 0;
+    for (int k = 1; k < params_.num_ants; ++k) {
+        if (scores[k] > scores[local_best] ||
+            (scores[k] == scores[local_best] && edges[k] > edges[local_best])) {
+            local_best = k;
+        }
+    }
+
+    // Cancelada: se conserva lo ya construido, sin búsqueda local ni feromonas
+    const bool interrupted = cancel_requested();
+
+    if (params_.local_search == LocalSearchMode::Best && !interrupted) {
+        MCS_PROFILE_PHASE(LocalSearch);
+        if (searchers_[0].improve(solutions[local_best], params_.local_search_steps)) {
+            scores[local_best] = static_cast<int>(solutions[local_best].size());
+            edges[local_best] = solutions[local_best].count_edges(g1_, g2_);
         }
     }
 
-    if (local_best_score > best_score_ ||
-        (local_best_score == best_score_ && local_best_edges > best_edges_)) {
+    const int local_best_score = scores[local_best];
+    const int local_best_edges = edges[local_best];
+
+    // Solo se copia al mejorar; la asignación reutiliza la memoria de best_solution_
+    const bool improved =
+        local_best_score > best_score_ ||
+        (local_best_score == best_score_ && local_best_edges > best_edges_);
+    if (improved) {
+        last_improvement_ = iter;
         best_score_ = local_best_score;
         best_edges_ = local_best_edges;
-        best_solution_ = local_best_solution;
+        best_solution_ = solutions[local_best];
+        publish_best(iter);
     }
+    if (interrupted) return improved;
 
-    pheromone_.evaporate(params_.rho);
-    update_pheromones(solutions, scores);
+    {
+        MCS_PROFILE_PHASE(PheromoneUpdate);
+        pheromone_.evaporate(params_.rho);
+        if (params_.mmas) update_bounds();
+        update_pheromones(solutions, scores, local_best);
+        if (params_.mmas) check_restart(iter);
+    }
+    return improved;
+}
+
+void ACO::update_bounds() {
+    if (best_score_ <= 0 || params_.rho <= 0.0) return;
+
+    // Equilibrio de depósitos best_score_ / ub que se evaporan a tasa rho
+    const double ub = static_cast<double>(upper_bound());
+    const double tau_max = best_score_ / (params_.rho * ub);
+
+    // Stützle y Hoos: con n componentes y avg opciones por paso
+    const double n = static_cast<double>(best_score_);
+    const double avg = std::max(2.0, g2_.num_vertices() / 2.0);
+    const double p_dec = std::pow(MMAS_P_BEST, 1.0 / n);
+    const double tau_min =
+        std::min(tau_max, tau_max * (1.0 - p_dec) / ((avg - 1.0) * p_dec));
+
+    const bool first = pheromone_.tau_max() == std::numeric_limits<double>::infinity();
+    pheromone_.set_bounds(tau_min, tau_max);
+    if (first) pheromone_.reset(tau_max);
+}
+
+void ACO::check_restart(int iter) {
+    if (params_.restart_convergence >= 1.0) return;
+    if ((iter + 1) % CONVERGENCE_CHECK_INTERVAL != 0) return;
+
+    // Los pares que ninguna hormiga visita se evaporan hasta tau_min y hacen
+    // subir el factor por sí solos; por eso además se exige estancamiento
+    if (iter - last_improvement_ < RESTART_STAGNATION) return;
+
+    if (pheromone_.convergence_factor() >= params_.restart_convergence) {
+        pheromone_.reset(pheromone_.tau_max());
+        ++restarts_;
+    }
 }
 
 void ACO::update_pheromones(const std::vector<Mapping>& solutions,
-                            const std::vector<int>& scores) {
+                            const std::vector<int>& scores,
+                            int iteration_best) {
+    if (params_.mmas) {
+        // Solo la mejor hormiga de la iteración deposita
+        const int score = scores[iteration_best];
+        if (score <= 0) return;
+        const double delta = score / static_cast<double>(upper_bound());
+        for (const auto& [u, v] : solutions[iteration_best].pairs()) {
+            pheromone_.deposit(u, v, delta);
+        }
+        return;
+    }
+
     const int max_score = *std::max_element(scores.begin(), scores.end());
     if (max_score <= 0) return;
 
@@ -119,14 +363,14 @@ void ACO::update_pheromones(const std::vector<Mapping>& solutions,
         const double quality = static_cast<double>(scores[i]) / max_score;
         const double delta = 2.0 * quality;
 
-        for (const auto& [u, v] : solutions[i].get_nodes_vector()) {
+        for (const auto& [u, v] : solutions[i].pairs()) {
             pheromone_.deposit(u, v, delta);
         }
     }
 
     if (best_score_ > 0) {
         const double elite = 5.0;
-        for (const auto& [u, v] : best_solution_.get_nodes_vector()) {
+        for (const auto& [u, v] : best_solution_.pairs()) {
             pheromone_.deposit(u, v, elite);
         }
     }
@@ -2,27 +2,32 @@
 #include "../include/graph.hpp"
 #include "../include/mapping.hpp"
 #include "../include/pheromone.hpp"
+#include "../include/profile.hpp"
 
 #include <algorithm>
-#include <cmath>
 #include <random>
 #include <utility>
 #include <vector>
 
 namespace mcs {
 
+// Tamaño máximo de la tabla de dominios por hormiga
+static constexpr std::size_t DOMAIN_LIMIT_BYTES = std::size_t{64} << 20;
+
 // ============================================================================
 // FUNCIÓN AUXILIAR: Reparar mapeo a inducido válido
 // ============================================================================
-static inline Mapping repair_to_induced(const Mapping& in,
-                                       const Graph& g1,
-                                       const Graph& g2) {
-    Mapping out;
-    for (const auto& [u, v] : in.get_nodes_vector()) {
-        if (out.is_mapped_g1(u) || out.is_mapped_g2(v)) continue;
-        if (out.is_feasible_add(u, v, g1, g2)) out.add_pair(u, v);
+// Reconstruye `in` sobre `scratch` (ya dimensionado) y los intercambia.
+static inline void repair_to_induced(Mapping& in,
+                                     Mapping& scratch,
+                                     const Graph& g1,
+                                     const Graph& g2) {
+    scratch.clear();
+    for (const auto& [u, v] : in.pairs()) {
+        if (scratch.is_mapped_g1(u) || scratch.is_mapped_g2(v)) continue;
+        if (scratch.is_feasible_add(u, v, g1, g2)) scratch.add_pair(u, v);
     }
-    return out;
+    std::swap(in, scratch);
 }
 
 // ============================================================================
@@ -34,24 +39,49 @@ Mapping Ant::construct_solution(const Graph& g1,
                                double alpha,
                                double beta) {
     Mapping mapping;
+    construct_solution(g1, g2, pheromone, alpha, beta, mapping);
+    return mapping;
+}
+
+void Ant::construct_solution(const Graph& g1,
+                             const Graph& g2,
+                             const PheromoneMatrix& pheromone,
+                             double alpha,
+                             double beta,
+                             Mapping& mapping) {
+    mapping.reset(g1.num_vertices(), g2.num_vertices());
+    repair_buf_.reset(g1.num_vertices(), g2.num_vertices());
     const int max_steps =
         static_cast<int>(std::min(g1.num_vertices(), g2.num_vertices()));
 
+    init_domains(g1, g2);
+    tau_pow_ = PowerKernel(alpha);
+    eta_pow_ = PowerKernel(beta);
+    mapped_nbrs_g1_.assign(g1.num_vertices(), 0);
+    mapped_nbrs_g2_.assign(g2.num_vertices(), 0);
+
     for (int step = 0; step < max_steps; ++step) {
-        auto [u, v] = select_next_pair(mapping, g1, g2, pheromone, alpha, beta);
+        auto [u, v] = select_next_pair(mapping, g1, g2, pheromone);
         if (u == -1) break;  // No hay más candidatos válidos
 
-        // Ya no hay cutoff - is_feasible_add garantiza validez
+        // Ya no hay cutoff - los dominios / is_feasible_add garantizan validez
         mapping.add_pair(u, v);
+        record_pair(u, v, g1, g2);
+        if (use_domains_) update_domains(u, v, g1, g2);
     }
 
     // Reparación final (debería ser no-op si todo fue válido)
-    return repair_to_induced(mapping, g1, g2);
+    repair_to_induced(mapping, repair_buf_, g1, g2);
 }
 
 // ============================================================================
 // HEURÍSTICA
 // ============================================================================
+void Ant::record_pair(Vertex u, Vertex v, const Graph& g1, const Graph& g2) {
+    g1.for_each_neighbor(u, [&](Vertex w) { ++mapped_nbrs_g1_[w]; });
+    g2.for_each_neighbor(v, [&](Vertex x) { ++mapped_nbrs_g2_[x]; });
+}
+
 double Ant::compute_heuristic(Vertex u,
                               Vertex v,
                               const Mapping& current,
@@ -64,20 +94,13 @@ double Ant::compute_heuristic(Vertex u,
 
     if (current.size() == 0) return (deg_u + deg_v + 1.0) * deg_sim;
 
-    int preserved = 0;
-    int mism = 0;
-    int checked = 0;
-
-    for (const auto& [um, vm] : current.get_nodes_vector()) {
-        const bool e1 = g1.edge(u, um);
-        const bool e2 = g2.edge(v, vm);
-        ++checked;
-        if (e1 && e2) ++preserved;
-        if (e1 != e2) ++mism;
-    }
+    // Aristas preservadas y discrepancias contra el mapeo (exactas si (u,v)
+    // es factible; ver mapped_nbrs_g1_)
+    const int preserved = std::min(mapped_nbrs_g1_[u], mapped_nbrs_g2_[v]);
+    const int mism = std::abs(mapped_nbrs_g1_[u] - mapped_nbrs_g2_[v]);
 
     const double density =
-        static_cast<double>(preserved) / std::max(1, checked);
+        static_cast<double>(preserved) / std::max(1, current.size());
 
     const double lambda = 2.0;
     const double soft = 1.0 / (1.0 + lambda * mism);
@@ -87,25 +110,106 @@ double Ant::compute_heuristic(Vertex u,
 }
 
 // ============================================================================
-// SELECCIÓN DE SIGUIENTE PAR (OPTIMIZADO)
+// DOMINIOS (FORWARD-CHECKING)
 // ============================================================================
-std::pair<Vertex, Vertex> Ant::select_next_pair(
-    const Mapping& current,
-    const Graph& g1,
-    const Graph& g2,
-    const PheromoneMatrix& pheromone,
-    double alpha,
-    double beta
-) {
+void Ant::init_domains(const Graph& g1, const Graph& g2) {
+    const std::size_t n1 = g1.num_vertices();
+    const std::size_t n2 = g2.num_vertices();
+    domain_words_ = words_for(n2);
+
+    use_domains_ = g2.is_dense() &&
+                   n1 * domain_words_ * sizeof(Word) <= DOMAIN_LIMIT_BYTES;
+    if (!use_domains_) return;
+
+    // Con el mapeo vacío todo par es factible
+    domains_.assign(n1 * domain_words_, ~Word{0});
+    if (n2 % WORD_BITS != 0) {
+        const Word tail = (Word{1} << (n2 % WORD_BITS)) - 1;
+        for (std::size_t u = 0; u < n1; ++u) {
+            domains_[u * domain_words_ + domain_words_ - 1] = tail;
+        }
+    }
+    domain_size_.assign(n1, static_cast<int>(n2));
+    prefix_.resize(n1 + 1);
+}
 
-    // Parámetros de muestreo
-    const int K = 1000;              // Candidatos finales
-    const int MAX_ATTEMPTS = K * 3; // Intentos de muestreo
+void Ant::update_domains(Vertex u, Vertex v,
+                         const Graph& g1, const Graph& g2) {
+    // (w,x) sigue siendo factible si edge(w,u) == edge(x,v) y x != v
+    const Word* row_v = g2.row(v);
+    const std::size_t vw = static_cast<std::size_t>(v) / WORD_BITS;
+    const Word v_bit = Word{1} << (v % WORD_BITS);
+    const Vertex n1 = static_cast<Vertex>(g1.num_vertices());
+
+    domain_size_[u] = 0;
+    std::fill_n(domains_.begin() + u * domain_words_, domain_words_, 0);
+
+    for (Vertex w = 0; w < n1; ++w) {
+        if (domain_size_[w] == 0) continue;
+
+        Word* dom = domains_.data() + w * domain_words_;
+        const Word flip = g1.edge(w, u) ? Word{0} : ~Word{0};
+        int size = 0;
+        for (std::size_t i = 0; i < domain_words_; ++i) {
+            dom[i] &= row_v[i] ^ flip;
+            size += popcount(dom[i]);
+        }
+        if (dom[vw] & v_bit) {
+            dom[vw] &= ~v_bit;
+            --size;
+        }
+        domain_size_[w] = size;
+    }
+}
+
+void Ant::sample_from_domains(std::size_t k) {
+    const std::size_t n1 = domain_size_.size();
+    prefix_[0] = 0;
+    for (std::size_t u = 0; u < n1; ++u) {
+        prefix_[u + 1] = prefix_[u] + domain_size_[u];
+    }
+    const long long total = prefix_[n1];
+    if (total == 0) return;
+
+    // r-ésimo par factible en el orden (u, v)
+    auto push_pair_at = [&](long long r) {
+        const auto it = std::upper_bound(prefix_.begin(), prefix_.end(), r);
+        const std::size_t u = static_cast<std::size_t>(it - prefix_.begin()) - 1;
+        long long rank = r - prefix_[u];
+        const Word* dom = domains_.data() + u * domain_words_;
+        std::size_t i = 0;
+        for (int c = popcount(dom[i]); rank >= c; c = popcount(dom[++i])) {
+            rank -= c;
+        }
+        Word bits = dom[i];
+        for (; rank > 0; --rank) bits &= bits - 1;
+        pool_.push(static_cast<Vertex>(u),
+                   static_cast<Vertex>(i * WORD_BITS + lowest_bit(bits)));
+    };
+
+    if (total <= static_cast<long long>(k)) {
+        // Pocos pares factibles: se evalúan todos
+        MCS_PROFILE_ADD(SampleAttempts, static_cast<std::uint64_t>(total));
+        for (long long r = 0; r < total; ++r) push_pair_at(r);
+        return;
+    }
+
+    std::uniform_int_distribution<long long> dr(0, total - 1);
+    MCS_PROFILE_ADD(SampleAttempts, k);
+    for (std::size_t i = 0; i < k; ++i) push_pair_at(dr(rng_));
+}
+
+void Ant::sample_by_rejection(const Mapping& current,
+                              const Graph& g1,
+                              const Graph& g2,
+                              std::size_t k) {
+    const std::size_t MAX_ATTEMPTS = k * 3; // Intentos de muestreo
 
     // Construir listas de nodos no mapeados
-    std::vector<Vertex> U, V;
-    U.reserve(g1.num_vertices());
-    V.reserve(g2.num_vertices());
+    std::vector<Vertex>& U = unmapped_g1_;
+    std::vector<Vertex>& V = unmapped_g2_;
+    U.clear();
+    V.clear();
 
     for (Vertex u = 0; u < static_cast<Vertex>(g1.num_vertices()); ++u)
         if (!current.is_mapped_g1(u)) U.push_back(u);
@@ -113,85 +217,99 @@ std::pair<Vertex, Vertex> Ant::select_next_pair(
     for (Vertex v = 0; v < static_cast<Vertex>(g2.num_vertices()); ++v)
         if (!current.is_mapped_g2(v)) V.push_back(v);
 
-    if (U.empty() || V.empty()) return {-1, -1};
+    if (U.empty() || V.empty()) return;
 
     std::uniform_int_distribution<int> du(0, static_cast<int>(U.size()) - 1);
     std::uniform_int_distribution<int> dv(0, static_cast<int>(V.size()) - 1);
 
-    // Pool de candidatos válidos
-    struct Cand { 
-        Vertex u, v; 
-    };
-    std::vector<Cand> pool;
-    pool.reserve(K);
-
-    // ========================================================================
-    // FASE 1: Muestreo con filtros
-    // ========================================================================
-    int attempts = 0;
-    while (static_cast<int>(pool.size()) < K && attempts < MAX_ATTEMPTS) {
+    std::size_t attempts = 0;
+    while (pool_.size() < k && attempts < MAX_ATTEMPTS) {
         Vertex u = U[du(rng_)];
         Vertex v = V[dv(rng_)];
+        ++attempts;
 
-        // Pre-filtro: diferencia de grados
-        int deg_diff = std::abs(g1.degree(u) - g2.degree(v));
-        if (deg_diff > 5) {
-            ++attempts;
-            continue;
-        }
-
-        // Filtro completo: factibilidad MCIS inducido
-        if (!current.is_feasible_add(u, v, g1, g2)) {
-            ++attempts;
-            continue;
-        }
+        // Sin pre-filtro por grado: los dominios tampoco lo aplican y la
+        // similitud de grados ya pesa en compute_heuristic
+        if (!current.is_feasible_add(u, v, g1, g2)) continue;
 
-        pool.push_back({u, v});
-        ++attempts;
+        pool_.push(u, v);
     }
+    MCS_PROFILE_ADD(SampleAttempts, attempts);
+}
+
+// ============================================================================
+// SELECCIÓN DE SIGUIENTE PAR (OPTIMIZADO)
+// ============================================================================
+std::pair<Vertex, Vertex> Ant::select_next_pair(
+    const Mapping& current,
+    const Graph& g1,
+    const Graph& g2,
+    const PheromoneMatrix& pheromone
+) {
+
+    MCS_PROFILE_PHASE(Selection);
+    MCS_PROFILE_COUNT(PairSelections);
 
-    if (pool.empty()) return {-1, -1};
+    // Parámetros de muestreo
+    const std::size_t K = 1000;      // Candidatos finales
 
     // ========================================================================
-    // FASE 2: Calcular probabilidades ACO
+    // FASE 1: Pool de candidatos factibles
     // ========================================================================
-    std::vector<double> values(pool.size());
-    double total = 0.0;
+    pool_.clear();
+    {
+        MCS_PROFILE_PHASE(Sampling);
+        if (use_domains_) {
+            sample_from_domains(K);
+        } else {
+            sample_by_rejection(current, g1, g2, K);
+        }
+    }
+    MCS_PROFILE_ADD(SampleAccepted, pool_.size());
 
-    for (std::size_t i = 0; i < pool.size(); ++i) {
-        Vertex u = pool[i].u;
-        Vertex v = pool[i].v;
+    if (pool_.empty()) return {-1, -1};
+    const std::size_t n = pool_.size();
 
-        double tau = std::max(pheromone.get(u, v), 1e-6);
-        double eta = compute_heuristic(u, v, current, g1, g2);
+    // ========================================================================
+    // FASE 2: Calcular pesos ACO: tau^alpha · eta^beta
+    // ========================================================================
+    pool_.tau.resize(n);
+    pool_.eta.resize(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const Vertex u = pool_.u[i];
+        const Vertex v = pool_.v[i];
+        pool_.tau[i] = std::max(pheromone.get(u, v), 1e-6);
+        pool_.eta[i] = compute_heuristic(u, v, current, g1, g2);
+    }
+    MCS_PROFILE_ADD(HeuristicEvals, n);
+
+    tau_pow_.apply(pool_.tau.data(), n);
+    eta_pow_.apply(pool_.eta.data(), n);
 
-        double val = std::pow(tau, alpha) * std::pow(eta, beta);
-        values[i] = val;
-        total += val;
+    // Sumas prefijas de los pesos (se guardan sobre eta)
+    double* cumulative = pool_.eta.data();
+    double total = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+        total += pool_.tau[i] * cumulative[i];
+        cumulative[i] = total;
     }
 
     // ========================================================================
-    // FASE 3: Selección probabilística (ruleta)
+    // FASE 3: Selección probabilística (ruleta por búsqueda binaria)
     // ========================================================================
     if (total <= 1e-12) {
         // Fallback: selección uniforme
-        std::uniform_int_distribution<int> pick(0, static_cast<int>(pool.size()) - 1);
-        auto c = pool[pick(rng_)];
-        return {c.u, c.v};
+        std::uniform_int_distribution<std::size_t> pick(0, n - 1);
+        const std::size_t i = pick(rng_);
+        return {pool_.u[i], pool_.v[i]};
     }
 
-    std::uniform_real_distribution<double> dist(0.0, 1.0);
-    double r = dist(rng_);
-    double acc = 0.0;
-
-    for (std::size_t i = 0; i < pool.size(); ++i) {
-        acc += values[i] / total;
-        if (r <= acc) {
-            return {pool[i].u, pool[i].v};
-        }
-    }
+    std::uniform_real_distribution<double> dist(0.0, total);
+    const double r = dist(rng_);
+    const std::size_t i = std::min<std::size_t>(
+        std::upper_bound(cumulative, cumulative + n, r) - cumulative, n - 1);
 
-    return {pool.back().u, pool.back().v};
+    return {pool_.u[i], pool_.v[i]};
 }
 
 } // namespace mcs
\ No newline at end of file
@@ -0,0 +1,181 @@
+#include "../include/batch.hpp"
+#include "../include/graph_cache.hpp"
+#include "../include/reader.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+namespace mcs {
+
+std::vector<std::string> list_graph_files(const std::string& path) {
+    namespace fs = std::filesystem;
+    std::vector<std::string> files;
+
+    if (fs::is_directory(path)) {
+        for (const auto& entry : fs::directory_iterator(path)) {
+            if (entry.is_regular_file()) files.push_back(entry.path().string());
+        }
+        std::sort(files.begin(), files.end());
+
+        // Un caché junto a su texto no es otra gráfica
+        const std::string ext = GRAPH_CACHE_EXTENSION;
+        const std::vector<std::string> all = files;
+        files.erase(std::remove_if(files.begin(), files.end(),
+                                   [&](const std::string& f) {
+                                       return f.size() > ext.size() &&
+                                              f.compare(f.size() - ext.size(), ext.size(), ext) == 0 &&
+                                              std::binary_search(all.begin(), all.end(),
+                                                                 f.substr(0, f.size() - ext.size()));
+                                   }),
+                    files.end());
+        return files;
+    }
+
+    std::ifstream list(path);
+    if (!list) {
+        throw std::runtime_error("No se puede abrir: " + path);
+    }
+    std::string line;
+    while (std::getline(list, line)) {
+        while (!line.empty() && (line.back() == '\r' || line.back() == ' ')) line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+        files.push_back(line);
+    }
+    return files;
+}
+
+BatchRunner::BatchRunner(const ACOParams& params, const BatchParams& batch)
+    : params_(params),
+      batch_(batch) {
+    // Paralelismo entre pares: cada par corre en un solo hilo y en silencio
+    params_.num_threads = 1;
+    params_.verbose = false;
+}
+
+std::vector<Graph> BatchRunner::load(const std::vector<std::string>& files) const {
+    std::vector<Graph> graphs(files.size(), Graph(0));
+    std::vector<std::string> errors(files.size());
+
+    #pragma omp parallel for schedule(dynamic)
+    for (std::size_t i = 0; i < files.size(); ++i) {
+        try {
+            Reader reader;
+            reader.set_write_cache(batch_.write_cache);
+            graphs[i] = reader.read_graph(files[i], batch_.storage);
+        } catch (const std::exception& e) {
+            errors[i] = e.what();
+        }
+    }
+
+    for (const std::string& error : errors) {
+        if (!error.empty()) throw std::runtime_error(error);
+    }
+    return graphs;
+}
+
+SolveResult BatchRunner::solve_pair(const Graph& g1, const Graph& g2) const {
+    SolveOptions options;
+    options.solver = batch_.solver;
+    options.aco = params_;
+    return solve(g1, g2, options);
+}
+
+void BatchRunner::run_query(const std::string& query,
+                            const std::vector<std::string>& targets) {
+    const std::vector<std::string> query_files{query};
+    const std::vector<Graph> queries = load(query_files);
+    const std::vector<Graph> graphs = load(targets);
+    run(query_files, queries, targets, graphs, false);
+}
+
+void BatchRunner::run_all_pairs(const std::vector<std::string>& files) {
+    const std::vector<Graph> graphs = load(files);
+    run(files, graphs, files, graphs, true);
+}
+
+void BatchRunner::run(const std::vector<std::string>& row_files,
+                      const std::vector<Graph>& rows,
+                      const std::vector<std::string>& col_files,
+                      const std::vector<Graph>& cols,
+                      bool symmetric) {
+    std::ofstream csv_file;
+    if (!batch_.csv_path.empty()) {
+        csv_file.open(batch_.csv_path);
+        if (!csv_file) {
+            throw std::runtime_error("No se puede crear: " + batch_.csv_path);
+        }
+    }
+    std::ostream& out = batch_.csv_path.empty() ? std::cout : csv_file;
+    out << "fila,columna,g1,g2,n1,n2,mcis,aristas,similitud,segundos\n";
+
+    const std::size_t n_rows = rows.size();
+    const std::size_t n_cols = cols.size();
+    std::vector<float> matrix(n_rows * n_cols, -1.0f);
+
+    // Pares a resolver; en modo simétrico solo i < j
+    std::vector<std::pair<std::size_t, std::size_t>> pairs;
+    for (std::size_t i = 0; i < n_rows; ++i) {
+        if (symmetric) matrix[i * n_cols + i] = 1.0f;
+        for (std::size_t j = symmetric ? i + 1 : 0; j < n_cols; ++j) {
+            pairs.emplace_back(i, j);
+        }
+    }
+
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (std::size_t k = 0; k < pairs.size(); ++k) {
+        const auto [i, j] = pairs[k];
+        const Graph& g1 = rows[i];
+        const Graph& g2 = cols[j];
+
+        const auto start = std::chrono::steady_clock::now();
+        const SolveResult result = solve_pair(g1, g2);
+        const std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+
+        const std::size_t larger = std::max(g1.num_vertices(), g2.num_vertices());
+        const double similarity =
+            larger > 0 ? static_cast<double>(result.size) / larger : 0.0;
+
+        matrix[i * n_cols + j] = static_cast<float>(similarity);
+        if (symmetric) matrix[j * n_cols + i] = static_cast<float>(similarity);
+
+        std::ostringstream line;
+        line << i << ',' << j << ',' << row_files[i] << ',' << col_files[j] << ','
+             << g1.num_vertices() << ',' << g2.num_vertices() << ','
+             << result.size << ',' << result.edges << ','
+             << std::fixed << std::setprecision(6) << similarity << ','
+             << std::setprecision(3) << elapsed.count() << '\n';
+
+        #pragma omp critical(batch_output)
+        {
+            out << line.str();
+            out.flush();
+        }
+    }
+
+    if (!batch_.matrix_path.empty()) write_matrix(matrix, n_rows, n_cols);
+}
+
+void BatchRunner::write_matrix(const std::vector<float>& matrix,
+                               std::size_t rows, std::size_t cols) const {
+    std::ofstream file(batch_.matrix_path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("No se puede crear: " + batch_.matrix_path);
+    }
+
+    const std::uint32_t header[3] = {1, static_cast<std::uint32_t>(rows),
+                                     static_cast<std::uint32_t>(cols)};
+    file.write("MCSM", 4);
+    file.write(reinterpret_cast<const char*>(header), sizeof header);
+    file.write(reinterpret_cast<const char*>(matrix.data()),
+               static_cast<std::streamsize>(matrix.size() * sizeof(float)));
+}
+
+} // namespace mcs
@@ -0,0 +1,30 @@
+#include "../include/buffered_writer.hpp"
+#include <algorithm>
+
+namespace mcs {
+
+BufferedWriter::BufferedWriter(const std::string& filename, std::size_t capacity)
+    : out_(filename, std::ios::binary),
+      buffer_(std::max<std::size_t>(capacity, 64)) {}
+
+BufferedWriter::~BufferedWriter() {
+    if (out_.is_open()) flush();
+}
+
+void BufferedWriter::flush() {
+    if (used_ > 0) out_.write(buffer_.data(), static_cast<std::streamsize>(used_));
+    used_ = 0;
+}
+
+void BufferedWriter::sync() {
+    flush();
+    out_.flush();
+}
+
+bool BufferedWriter::close() {
+    flush();
+    out_.close();
+    return static_cast<bool>(out_);
+}
+
+} // namespace mcs
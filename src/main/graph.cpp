@@ -1,20 +1,142 @@
 #include "../include/graph.hpp"
+#include <stdexcept>
 
 namespace mcs {
 
-Graph::Graph(std::size_t n) : n_(n), adj_(n * n, 0), degrees_(n, 0) {}
+// Auto: la matriz de bits se usa mientras no pase de este tamaño o mientras
+// no sea al menos 4 veces mayor que el CSR equivalente.
+static constexpr std::size_t AUTO_DENSE_LIMIT_BYTES = std::size_t{64} << 20;
 
-void Graph::add_edge(Vertex u, Vertex v) {
-    adj_[u * n_ + v] = 1;
-    adj_[v * n_ + u] = 1;
-    degrees_[u]++;
-    degrees_[v]++;
+static bool choose_dense(std::size_t n, std::size_t num_edges,
+                         GraphStorage storage) {
+    if (storage == GraphStorage::Dense) return true;
+    if (storage == GraphStorage::Sparse) return false;
+
+    const std::size_t dense_bytes = n * words_for(n) * sizeof(Word);
+    const std::size_t sparse_bytes =
+        (n + 1) * sizeof(std::size_t) + 2 * num_edges * sizeof(Vertex);
+    return dense_bytes <= AUTO_DENSE_LIMIT_BYTES ||
+           dense_bytes < 4 * sparse_bytes;
+}
+
+Graph::Graph(std::size_t n)
+    : n_(n), words_(words_for(n)), adj_(n * words_, 0), degrees_(n, 0) {
+    bind();
+}
+
+Graph::Graph(std::size_t n,
+             const std::vector<std::pair<Vertex, Vertex>>& edges,
+             GraphStorage storage)
+    : n_(n), dense_(choose_dense(n, edges.size(), storage)), degrees_(n, 0) {
+    if (dense_) {
+        words_ = words_for(n);
+        adj_.assign(n * words_, 0);
+        bind();
+        for (const auto& [u, v] : edges) add_edge(u, v);
+        return;
+    }
+
+    // CSR: contar, repartir y luego ordenar/deduplicar cada fila
+    std::vector<std::size_t> counts(n + 1, 0);
+    for (const auto& [u, v] : edges) {
+        counts[u + 1]++;
+        if (u != v) counts[v + 1]++;
+    }
+    for (std::size_t i = 0; i < n; ++i) counts[i + 1] += counts[i];
+
+    std::vector<Vertex> raw(counts[n]);
+    std::vector<std::size_t> fill(counts.begin(), counts.end() - 1);
+    for (const auto& [u, v] : edges) {
+        raw[fill[u]++] = v;
+        if (u != v) raw[fill[v]++] = u;
+    }
+
+    offsets_.assign(n + 1, 0);
+    targets_.reserve(raw.size());
+    for (std::size_t u = 0; u < n; ++u) {
+        auto first = raw.begin() + counts[u];
+        auto last = raw.begin() + counts[u + 1];
+        std::sort(first, last);
+        last = std::unique(first, last);
+        for (auto it = first; it != last; ++it) {
+            targets_.push_back(*it);
+            // Un lazo cuenta doble, igual que en add_edge
+            degrees_[u] += (*it == static_cast<Vertex>(u)) ? 2 : 1;
+        }
+        offsets_[u + 1] = targets_.size();
+    }
+    targets_.shrink_to_fit();
+    bind();
+}
+
+Graph Graph::dense_view(std::size_t n, const Word* adj, const int* degrees,
+                        std::shared_ptr<const void> backing) {
+    Graph g(0);
+    g.n_ = n;
+    g.words_ = words_for(n);
+    g.adj_data_ = adj;
+    g.degrees_data_ = degrees;
+    g.backing_ = std::move(backing);
+    return g;
 }
 
-bool Graph::edge(Vertex u, Vertex v) const {
-    return adj_[u * n_ + v];
+Graph Graph::sparse_view(std::size_t n, const std::size_t* offsets,
+                         const Vertex* targets, const int* degrees,
+                         std::shared_ptr<const void> backing) {
+    Graph g(0);
+    g.n_ = n;
+    g.dense_ = false;
+    g.words_ = 0;
+    g.offsets_data_ = offsets;
+    g.targets_data_ = targets;
+    g.degrees_data_ = degrees;
+    g.backing_ = std::move(backing);
+    return g;
 }
 
+Graph::Graph(const Graph& other)
+    : n_(other.n_),
+      dense_(other.dense_),
+      words_(other.words_),
+      adj_(other.adj_),
+      offsets_(other.offsets_),
+      targets_(other.targets_),
+      degrees_(other.degrees_),
+      adj_data_(other.adj_data_),
+      offsets_data_(other.offsets_data_),
+      targets_data_(other.targets_data_),
+      degrees_data_(other.degrees_data_),
+      backing_(other.backing_) {
+    if (!backing_) bind();
+}
+
+Graph& Graph::operator=(const Graph& other) {
+    if (this != &other) *this = Graph(other);
+    return *this;
+}
+
+void Graph::bind() {
+    adj_data_ = adj_.data();
+    offsets_data_ = offsets_.data();
+    targets_data_ = targets_.data();
+    degrees_data_ = degrees_.data();
+}
+
+void Graph::add_edge(Vertex u, Vertex v) {
+    if (!dense_ || backing_) {
+        throw std::logic_error("add_edge requiere almacenamiento denso propio");
+    }
+
+    // Aristas repetidas no deben inflar el grado
+    if (edge(u, v)) return;
+
+    Word* ru = adj_.data() + static_cast<std::size_t>(u) * words_;
+    Word* rv = adj_.data() + static_cast<std::size_t>(v) * words_;
+    ru[v / WORD_BITS] |= Word{1} << (v % WORD_BITS);
+    rv[u / WORD_BITS] |= Word{1} << (u % WORD_BITS);
+    degrees_[u]++;
+    degrees_[v]++;
+}
 
 std::size_t Graph::num_vertices() const {
     return n_;
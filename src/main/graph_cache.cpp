@@ -0,0 +1,337 @@
+#include "../include/graph_cache.hpp"
+#include "../include/mapped_file.hpp"
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define MCS_HAVE_GETPID 1
+#include <unistd.h>
+#else
+#include <random>
+#endif
+
+namespace mcs {
+
+namespace fs = std::filesystem;
+
+// Los offsets CSR se mapean tal cual como std::size_t
+static_assert(sizeof(std::size_t) == sizeof(std::uint64_t),
+              "el caché .mcsg requiere std::size_t de 64 bits");
+
+static constexpr std::uint32_t CACHE_VERSION = 1;
+static constexpr std::uint32_t FLAG_DENSE = 1;
+static constexpr std::size_t SECTION_ALIGN = 64;
+
+namespace {
+
+struct CacheHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t flags;
+    std::uint32_t reserved;
+    std::uint64_t n;
+    std::uint64_t words;
+    std::uint64_t entries;
+    std::uint64_t name_bytes;
+    std::uint64_t source_size;
+    std::int64_t source_mtime;
+};
+static_assert(sizeof(CacheHeader) == 64, "encabezado .mcsg de 64 bytes");
+
+// Aritmética de tamaños que detecta desbordamiento (el encabezado puede venir dañado)
+bool checked_add(std::size_t a, std::size_t b, std::size_t& out) {
+    if (a > std::numeric_limits<std::size_t>::max() - b) return false;
+    out = a + b;
+    return true;
+}
+
+bool checked_mul(std::size_t a, std::size_t b, std::size_t& out) {
+    if (b != 0 && a > std::numeric_limits<std::size_t>::max() / b) return false;
+    out = a * b;
+    return true;
+}
+
+bool align_up(std::size_t x, std::size_t& out) {
+    if (!checked_add(x, SECTION_ALIGN - 1, out)) return false;
+    out = out / SECTION_ALIGN * SECTION_ALIGN;
+    return true;
+}
+
+/// Posición de cada sección dentro del archivo; valid = false si algún tamaño desborda.
+struct Layout {
+    std::size_t degrees = 0, adj = 0, offsets = 0, targets = 0, name_offsets = 0,
+                chars = 0, total = 0;
+    bool valid = false;
+
+    explicit Layout(const CacheHeader& h) {
+        std::size_t bytes, end;
+        degrees = sizeof(CacheHeader);
+        if (!checked_mul(h.n, sizeof(int), bytes) ||
+            !checked_add(degrees, bytes, end) || !align_up(end, adj)) {
+            return;
+        }
+        offsets = targets = adj;
+        if (h.flags & FLAG_DENSE) {
+            if (!checked_mul(h.n, h.words, bytes) ||
+                !checked_mul(bytes, sizeof(Word), bytes) ||
+                !checked_add(adj, bytes, end)) {
+                return;
+            }
+        } else {
+            if (!checked_add(h.n, 1, bytes) ||
+                !checked_mul(bytes, sizeof(std::uint64_t), bytes) ||
+                !checked_add(offsets, bytes, end) || !align_up(end, targets) ||
+                !checked_mul(h.entries, sizeof(Vertex), bytes) ||
+                !checked_add(targets, bytes, end)) {
+                return;
+            }
+        }
+        if (!align_up(end, name_offsets) ||
+            !checked_add(h.n, 1, bytes) ||
+            !checked_mul(bytes, sizeof(std::uint64_t), bytes) ||
+            !checked_add(name_offsets, bytes, chars) ||
+            !checked_add(chars, h.name_bytes, total)) {
+            return;
+        }
+        valid = true;
+    }
+};
+
+/// true si offsets[0..n] empieza en 0, no decrece y termina en last.
+bool monotone_offsets(const std::uint64_t* offsets, std::size_t n, std::uint64_t last) {
+    if (offsets[0] != 0 || offsets[n] != last) return false;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (offsets[i] > offsets[i + 1]) return false;
+    }
+    return true;
+}
+
+// "<path>.<pid>.<n>.tmp", único por proceso y por llamada
+std::string temp_path(const std::string& path) {
+    static std::atomic<unsigned> counter{0};
+#ifdef MCS_HAVE_GETPID
+    const long long pid = static_cast<long long>(::getpid());
+#else
+    const long long pid = static_cast<long long>(std::random_device{}());
+#endif
+    return path + "." + std::to_string(pid) + "." + std::to_string(counter++) + ".tmp";
+}
+
+// Tamaño y fecha del texto de origen (false si no existe)
+bool source_stamp(const std::string& source, std::uint64_t& size,
+                  std::int64_t& mtime) {
+    std::error_code ec;
+    size = fs::file_size(source, ec);
+    if (ec) return false;
+    const auto time = fs::last_write_time(source, ec);
+    if (ec) return false;
+    mtime = static_cast<std::int64_t>(time.time_since_epoch().count());
+    return true;
+}
+
+class CacheWriter {
+public:
+    explicit CacheWriter(const std::string& path)
+        : out_(path, std::ios::binary) {
+        if (!out_) throw std::runtime_error("No se puede crear: " + path);
+    }
+
+    void write(const void* data, std::size_t bytes) {
+        out_.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+        pos_ += bytes;
+    }
+
+    void pad_to(std::size_t pos) {
+        static const char zeros[SECTION_ALIGN] = {};
+        write(zeros, pos - pos_);
+    }
+
+    bool ok() { out_.flush(); return static_cast<bool>(out_); }
+
+    void close() { out_.close(); }
+
+private:
+    std::ofstream out_;
+    std::size_t pos_ = 0;
+};
+
+// Cada grado coincide con su fila (un lazo cuenta doble, como en Graph) y
+// ninguna fila tiene bits más allá de n en su última palabra
+bool valid_dense_rows(const Word* adj, std::size_t n, const int* degrees) {
+    const std::size_t words = words_for(n);
+    const std::size_t tail = n % WORD_BITS;
+    const Word padding = tail == 0 ? Word{0} : ~Word{0} << tail;
+    for (std::size_t u = 0; u < n; ++u) {
+        const Word* row = adj + u * words;
+        if (words > 0 && (row[words - 1] & padding) != 0) return false;
+        long long degree = 0;
+        for (std::size_t w = 0; w < words; ++w) degree += popcount(row[w]);
+        degree += (row[u / WORD_BITS] >> (u % WORD_BITS)) & 1u;
+        if (degrees[u] != degree) return false;
+    }
+    return true;
+}
+
+// Vecinos en [0, n) y estrictamente crecientes en cada fila (edge() hace
+// búsqueda binaria); cada grado coincide con su fila
+bool valid_csr_rows(const std::uint64_t* offsets, const Vertex* targets,
+                    std::size_t n, const int* degrees) {
+    for (std::size_t u = 0; u < n; ++u) {
+        long long degree = 0;
+        Vertex previous = -1;
+        for (std::uint64_t i = offsets[u]; i < offsets[u + 1]; ++i) {
+            const Vertex x = targets[i];
+            if (x <= previous || static_cast<std::size_t>(x) >= n) return false;
+            degree += static_cast<std::size_t>(x) == u ? 2 : 1;
+            previous = x;
+        }
+        if (degrees[u] != degree) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+void write_graph_cache(const std::string& path, const Graph& g,
+                       const std::vector<std::string>& names,
+                       const std::string& source) {
+    const std::size_t n = g.num_vertices();
+    if (names.size() != n) {
+        throw std::logic_error("write_graph_cache: un nombre por vértice");
+    }
+
+    CacheHeader h{};
+    std::memcpy(h.magic, "MCSG", 4);
+    h.version = CACHE_VERSION;
+    h.flags = g.is_dense() ? FLAG_DENSE : 0;
+    h.n = n;
+    h.words = g.is_dense() ? g.words_per_row() : 0;
+    if (!g.is_dense()) {
+        for (std::size_t u = 0; u < n; ++u) h.entries += g.neighbors(u).size();
+    }
+    for (const std::string& name : names) h.name_bytes += name.size();
+    if (!source.empty()) source_stamp(source, h.source_size, h.source_mtime);
+    const Layout layout(h);
+
+    // Temporal propio de este escritor: otro proceso u otro hilo que escriba
+    // el mismo caché usa otro nombre, así que nunca se renombra uno mezclado
+    const std::string tmp = temp_path(path);
+    try {
+        CacheWriter out(tmp);
+        out.write(&h, sizeof h);
+
+        for (std::size_t u = 0; u < n; ++u) {
+            const int d = g.degree(static_cast<Vertex>(u));
+            out.write(&d, sizeof d);
+        }
+
+        out.pad_to(layout.adj);
+        if (g.is_dense()) {
+            out.write(g.row(0), n * h.words * sizeof(Word));
+        } else {
+            std::uint64_t offset = 0;
+            out.write(&offset, sizeof offset);
+            for (std::size_t u = 0; u < n; ++u) {
+                offset += g.neighbors(static_cast<Vertex>(u)).size();
+                out.write(&offset, sizeof offset);
+            }
+            out.pad_to(layout.targets);
+            for (std::size_t u = 0; u < n; ++u) {
+                const NeighborRange r = g.neighbors(static_cast<Vertex>(u));
+                out.write(r.begin(), r.size() * sizeof(Vertex));
+            }
+        }
+
+        out.pad_to(layout.name_offsets);
+        std::uint64_t offset = 0;
+        out.write(&offset, sizeof offset);
+        for (const std::string& name : names) {
+            offset += name.size();
+            out.write(&offset, sizeof offset);
+        }
+        for (const std::string& name : names) out.write(name.data(), name.size());
+
+        if (!out.ok()) throw std::runtime_error("Error al escribir: " + tmp);
+        out.close();
+        fs::rename(tmp, path);
+    } catch (...) {
+        std::error_code ec;
+        fs::remove(tmp, ec);
+        throw;
+    }
+}
+
+bool load_graph_cache(const std::string& path, const std::string& source,
+                      GraphStorage storage, Graph& g,
+                      std::vector<std::string>& names) {
+    std::error_code ec;
+    if (!fs::is_regular_file(path, ec)) return false;
+
+    auto file = std::make_shared<MappedFile>(path);
+    if (file->size() < sizeof(CacheHeader)) return false;
+
+    CacheHeader h;
+    std::memcpy(&h, file->data(), sizeof h);
+    if (std::memcmp(h.magic, "MCSG", 4) != 0 || h.version != CACHE_VERSION) {
+        return false;
+    }
+    const bool dense = (h.flags & FLAG_DENSE) != 0;
+    if ((storage == GraphStorage::Dense && !dense) ||
+        (storage == GraphStorage::Sparse && dense)) {
+        return false;
+    }
+    if (h.n > static_cast<std::uint64_t>(std::numeric_limits<Vertex>::max()) ||
+        (dense && h.words != words_for(h.n))) {
+        return false;
+    }
+
+    if (!source.empty()) {
+        std::uint64_t size = 0;
+        std::int64_t mtime = 0;
+        if (!source_stamp(source, size, mtime) || size != h.source_size ||
+            mtime != h.source_mtime) {
+            return false;
+        }
+    }
+
+    const Layout layout(h);
+    if (!layout.valid || file->size() < layout.total) return false;
+
+    // Todo lo que se indexa con datos del archivo se valida antes de usarse:
+    // un caché dañado debe rechazarse, no leerse fuera del mapeo
+    const std::size_t n = static_cast<std::size_t>(h.n);
+    const char* base = file->data();
+    const auto* name_offsets =
+        reinterpret_cast<const std::uint64_t*>(base + layout.name_offsets);
+    if (!monotone_offsets(name_offsets, n, h.name_bytes)) return false;
+
+    const auto* degrees = reinterpret_cast<const int*>(base + layout.degrees);
+    if (dense) {
+        const auto* adj = reinterpret_cast<const Word*>(base + layout.adj);
+        if (!valid_dense_rows(adj, n, degrees)) return false;
+        g = Graph::dense_view(n, adj, degrees, file);
+    } else {
+        const auto* offsets = reinterpret_cast<const std::uint64_t*>(base + layout.offsets);
+        if (!monotone_offsets(offsets, n, h.entries)) return false;
+        const auto* targets = reinterpret_cast<const Vertex*>(base + layout.targets);
+        if (!valid_csr_rows(offsets, targets, n, degrees)) return false;
+        g = Graph::sparse_view(n, reinterpret_cast<const std::size_t*>(offsets),
+                               targets, degrees, file);
+    }
+
+    const char* chars = base + layout.chars;
+    names.clear();
+    names.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        names.emplace_back(chars + name_offsets[i], name_offsets[i + 1] - name_offsets[i]);
+    }
+    return true;
+}
+
+} // namespace mcs
@@ -1,6 +1,6 @@
 #include "../include/graphy.hpp"
 #include "../include/graph.hpp"
-#include <fstream>
+#include "../include/profile.hpp"
 #include <cmath>
 #include <iostream>
 #include <algorithm>
@@ -15,44 +15,44 @@ Graphy::Graphy(const Graph& graph,
                const std::vector<std::string>& id_to_name) 
     : graph_(graph), id_to_name_(id_to_name) {}
 
-std::string Graphy::dimensionaLienzo(int ancho, int alto) {
-    return " width='" + std::to_string(ancho) +
-           "' height='" + std::to_string(alto) + "'>\n";
+void Graphy::dimensionaLienzo(BufferedWriter& out, int ancho, int alto) {
+    out << " width='" << ancho << "' height='" << alto << "'>\n";
 }
 
-std::string Graphy::dibujaArista(
+void Graphy::dibujaArista(
+    BufferedWriter& out,
     int x1, int y1, int x2, int y2,
-    const std::string& color, int stroke_width
+    const char* color, int stroke_width
 ) {
-    return "\t<line x1='" + std::to_string(x1) +
-           "' y1='" + std::to_string(y1) +
-           "' x2='" + std::to_string(x2) +
-           "' y2='" + std::to_string(y2) +
-           "' stroke='" + color +
-           "' stroke-width='" + std::to_string(stroke_width) + "' />\n";
+    out << "\t<line x1='" << x1
+        << "' y1='" << y1
+        << "' x2='" << x2
+        << "' y2='" << y2
+        << "' stroke='" << color
+        << "' stroke-width='" << stroke_width << "' />\n";
 }
 
-std::string Graphy::escribe(
+void Graphy::escribe(
+    BufferedWriter& out,
     int x, int y, const std::string& texto,
-    const std::string& color
+    const char* color
 ) {
-    return "\t<text x='" + std::to_string(x) +
-           "' y='" + std::to_string(y) +
-           "' fill='" + color +
-           "' font-family='Arial' font-size='14' text-anchor='middle'>" +
-           texto + "</text>\n";
+    out << "\t<text x='" << x
+        << "' y='" << y
+        << "' fill='" << color
+        << "' font-family='Arial' font-size='14' text-anchor='middle'>"
+        << texto << "</text>\n";
 }
 
-std::string Graphy::dibujaVertice(
+void Graphy::dibujaVertice(
+    BufferedWriter& out,
     const std::string& nombre, int x, int y,
-    const std::string& color
+    const char* color
 ) {
-    std::string s =
-        "\t<circle cx='" + std::to_string(x) +
-        "' cy='" + std::to_string(y) +
-        "' r='20' fill='white' stroke='black' stroke-width='2'/>\n";
-    s += escribe(x, y + 5, nombre, color);
-    return s;
+    out << "\t<circle cx='" << x
+        << "' cy='" << y
+        << "' r='20' fill='white' stroke='black' stroke-width='2'/>\n";
+    escribe(out, x, y + 5, nombre, color);
 }
 
 void Graphy::dibujaSubgraficaInducidaCircular(
@@ -64,6 +64,14 @@ void Graphy::dibujaSubgraficaInducidaCircular(
         std::cout << "[Graphy] Subgrafica vacío, no se genera SVG.\n";
         return;
     }
+    MCS_PROFILE_PHASE(Svg);
+
+    BufferedWriter out(output_file);
+    if (!out.is_open()) {
+        std::cerr << "[Graphy] Error: no se pudo crear " 
+                  << output_file << "\n";
+        return;
+    }
 
     const int radio = std::max(200, k * 15);
     const int ancho = 2 * radio + 100;
@@ -80,23 +88,30 @@ void Graphy::dibujaSubgraficaInducidaCircular(
         ys[i] = static_cast<int>(cy + radio * std::sin(angulo));
     }
 
-    svg_.clear();
-    svg_ += INICIO;
-    svg_ += dimensionaLienzo(ancho, alto);
+    out << INICIO;
+    dimensionaLienzo(out, ancho, alto);
 
-    // Dibujar aristas inducidas
+    // Dibujar aristas inducidas: se recorren los vecinos de cada vértice
+    // (O(|E|) en vez de O(k²) consultas) y se ordenan por posición para
+    // conservar el orden de los pares (i, j)
+    posicion_.assign(graph_.num_vertices(), -1);
+    for (int i = 0; i < k; ++i) posicion_[subset[i]] = i;
+
+    std::vector<int> vecinos;
     for (int i = 0; i < k; ++i) {
-        for (int j = i + 1; j < k; ++j) {
-            int u = subset[i];
-            int v = subset[j];
-
-            if (graph_.edge(u, v)) {
-                svg_ += dibujaArista(
-                    xs[i], ys[i],
-                    xs[j], ys[j],
-                    "#2563eb", 2
-                );
-            }
+        vecinos.clear();
+        graph_.for_each_neighbor(subset[i], [&](Vertex x) {
+            if (posicion_[x] > i) vecinos.push_back(posicion_[x]);
+        });
+        std::sort(vecinos.begin(), vecinos.end());
+
+        for (int j : vecinos) {
+            dibujaArista(
+                out,
+                xs[i], ys[i],
+                xs[j], ys[j],
+                "#2563eb", 2
+            );
         }
     }
 
@@ -105,28 +120,19 @@ void Graphy::dibujaSubgraficaInducidaCircular(
         int vertex_id = subset[i];
         
         // Validar que el id existe en el mapeo
-        std::string nombre;
         if (vertex_id >= 0 && 
             vertex_id < static_cast<int>(id_to_name_.size())) {
-            nombre = id_to_name_[vertex_id];
+            dibujaVertice(out, id_to_name_[vertex_id], xs[i], ys[i], "black");
         } else {
-            nombre = std::to_string(vertex_id);  // Fallback
+            dibujaVertice(out, std::to_string(vertex_id), xs[i], ys[i], "black");  // Fallback
         }
-        
-        svg_ += dibujaVertice(nombre, xs[i], ys[i], "black");
     }
 
-    svg_ += FINAL;
+    out << FINAL;
 
-    std::ofstream out(output_file);
-    if (!out) {
-        std::cerr << "[Graphy] Error: no se pudo crear " 
-                  << output_file << "\n";
-        return;
+    if (!out.close()) {
+        std::cerr << "[Graphy] Error al escribir " << output_file << "\n";
     }
-    
-    out << svg_;
-    out.close();
 }
 
-} // namespace mcs
\ No newline at end of file
+} // namespace mcs
@@ -0,0 +1,233 @@
+#include "../include/islands.hpp"
+#include "../include/rng.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace mcs {
+
+#ifdef _OPENMP
+namespace {
+
+/// Sube max-active-levels durante solve() y lo restaura al salir: es un
+/// ajuste de todo el proceso y la biblioteca no debe dejarlo cambiado.
+class NestingGuard {
+public:
+    explicit NestingGuard(int levels) : saved_(omp_get_max_active_levels()) {
+        if (levels > saved_) omp_set_max_active_levels(levels);
+    }
+    ~NestingGuard() { omp_set_max_active_levels(saved_); }
+
+    NestingGuard(const NestingGuard&) = delete;
+    NestingGuard& operator=(const NestingGuard&) = delete;
+
+private:
+    int saved_;
+};
+
+} // namespace
+#endif
+
+IslandModel::IslandModel(const Graph& g1, const Graph& g2,
+                         const ACOParams& params,
+                         const IslandParams& island_params)
+    : g1_(g1),
+      g2_(g2),
+      params_(params),
+      island_params_(island_params) {
+    const int islands = std::max(1, island_params_.islands);
+    island_params_.islands = islands;
+    island_params_.migration_interval = std::max(1, island_params_.migration_interval);
+
+#ifdef _OPENMP
+    const int total = params.num_threads > 0 ? params.num_threads : omp_get_max_threads();
+#else
+    const int total = 1;
+#endif
+    threads_per_island_ = std::max(1, total / islands);
+
+    // La isla 0 conserva la semilla, así que una sola isla equivale al ACO
+    for (int i = 0; i < islands; ++i) {
+        ACOParams colony = params;
+        colony.num_threads = threads_per_island_;
+        if (i > 0) {
+            colony.seed = static_cast<int>(
+                SplitMix64::mix(static_cast<std::uint64_t>(params.seed) + i) & 0x7fffffff);
+        }
+        colonies_.push_back(std::make_unique<ACO>(g1, g2, colony));
+    }
+}
+
+void IslandModel::set_telemetry(TelemetryWriter* sink) {
+    for (std::size_t i = 0; i < colonies_.size(); ++i) {
+        colonies_[i]->set_telemetry(sink, static_cast<int>(i));
+    }
+}
+
+void IslandModel::set_cancellation(const CancellationToken* token) {
+    cancel_ = token;
+    for (auto& colony : colonies_) colony->set_cancellation(token);
+}
+
+void IslandModel::set_anytime(AnytimeBest* sink) {
+    for (auto& colony : colonies_) colony->set_anytime(sink);
+}
+
+std::size_t IslandModel::best_island() const {
+    std::size_t best = 0;
+    for (std::size_t i = 1; i < colonies_.size(); ++i) {
+        const ACO& a = *colonies_[i];
+        const ACO& b = *colonies_[best];
+        if (a.get_best_score() > b.get_best_score() ||
+            (a.get_best_score() == b.get_best_score() &&
+             a.get_best_edges() > b.get_best_edges())) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+void IslandModel::migrate() {
+    const std::size_t n = colonies_.size();
+    if (n < 2) return;
+
+    const bool pheromone = island_params_.migration == Migration::Pheromone;
+    const double w = island_params_.blend;
+
+    if (island_params_.topology == Topology::Full) {
+        // Todas reciben de la isla con la mejor solución
+        const std::size_t b = best_island();
+        for (std::size_t i = 0; i < n; ++i) {
+            if (i == b) continue;
+            if (pheromone) {
+                colonies_[i]->pheromone().blend(colonies_[b]->pheromone(), w);
+            } else {
+                colonies_[i]->accept_migrant(colonies_[b]->get_best_solution());
+            }
+        }
+        return;
+    }
+
+    // Anillo: i recibe de i - 1. Se recorre hacia atrás para que cada emisor
+    // aún no haya recibido; la última isla se copia antes para la isla 0.
+    if (pheromone) {
+        const PheromoneMatrix last = colonies_[n - 1]->pheromone();
+        for (std::size_t i = n - 1; i > 0; --i) {
+            colonies_[i]->pheromone().blend(colonies_[i - 1]->pheromone(), w);
+        }
+        colonies_[0]->pheromone().blend(last, w);
+    } else {
+        const Mapping last = colonies_[n - 1]->get_best_solution();
+        for (std::size_t i = n - 1; i > 0; --i) {
+            colonies_[i]->accept_migrant(colonies_[i - 1]->get_best_solution());
+        }
+        colonies_[0]->accept_migrant(last);
+    }
+}
+
+Mapping IslandModel::solve() {
+    const int islands = island_params_.islands;
+    if (params_.verbose) {
+        std::cout << "ACO (MCIS inducido), modelo de islas\n";
+        std::cout << "G1 vertices: " << g1_.num_vertices() << "\n";
+        std::cout << "G2 vertices: " << g2_.num_vertices() << "\n";
+        std::cout << "Islas: " << islands << " × " << params_.num_ants
+                  << " hormigas, " << threads_per_island_ << " hilo(s) por isla\n";
+        std::cout << "Migración cada " << island_params_.migration_interval
+                  << " iteraciones (" << (island_params_.topology == Topology::Ring ? "anillo" : "completa")
+                  << ", " << (island_params_.migration == Migration::Solution ? "soluciones" : "feromonas")
+                  << ")\n";
+        std::cout << "Iteraciones: " << params_.max_iterations << "\n\n";
+    }
+
+#ifdef _OPENMP
+    // Un equipo por isla y, dentro, el de la colonia
+    const NestingGuard nesting(threads_per_island_ > 1 ? 2 : 1);
+    const int outer = std::min(islands, std::max(1, omp_get_max_threads()));
+#endif
+
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point start = Clock::now();
+    const int bound = colonies_[0]->upper_bound();
+    const char* stop_reason = "iteraciones";
+
+    int best_score = 0, best_edges = 0;
+    int stagnation = 0;
+    iterations_run_ = 0;
+    cancelled_ = false;
+
+    while (iterations_run_ < params_.max_iterations) {
+        const int chunk = std::min(island_params_.migration_interval,
+                                   params_.max_iterations - iterations_run_);
+
+        #pragma omp parallel for schedule(static, 1) num_threads(outer)
+        for (int i = 0; i < islands; ++i) {
+            for (int k = 0; k < chunk; ++k) {
+                if (cancel_ && cancel_->is_cancelled()) break;
+                colonies_[i]->step();
+            }
+        }
+        iterations_run_ += chunk;
+
+        const ACO& leader = *colonies_[best_island()];
+        if (leader.get_best_score() > best_score ||
+            (leader.get_best_score() == best_score && leader.get_best_edges() > best_edges)) {
+            best_score = leader.get_best_score();
+            best_edges = leader.get_best_edges();
+            stagnation = 0;
+        } else {
+            stagnation += chunk;
+        }
+
+        if (cancel_ && cancel_->is_cancelled()) {
+            cancelled_ = true;
+            stop_reason = "cancelado";
+            break;
+        }
+        if (progress_) {
+            const std::chrono::duration<double> elapsed = Clock::now() - start;
+            if (!progress_({iterations_run_, best_score, best_edges, elapsed.count()})) {
+                cancelled_ = true;
+                stop_reason = "cancelado";
+                break;
+            }
+        }
+
+        // Criterios de parada (entre migraciones)
+        if (best_score >= bound) {
+            stop_reason = "cota superior alcanzada (óptimo)";
+            break;
+        }
+        if (params_.target_size > 0 && best_score >= params_.target_size) {
+            stop_reason = "tamaño objetivo alcanzado";
+            break;
+        }
+        if (params_.max_stagnation > 0 && stagnation >= params_.max_stagnation) {
+            stop_reason = "estancamiento";
+            break;
+        }
+        if (params_.time_limit > 0.0) {
+            const std::chrono::duration<double> elapsed = Clock::now() - start;
+            if (elapsed.count() >= params_.time_limit) {
+                stop_reason = "límite de tiempo";
+                break;
+            }
+        }
+
+        if (iterations_run_ < params_.max_iterations) migrate();
+    }
+
+    if (params_.verbose) {
+        std::cout << "Parada: " << stop_reason << " tras " << iterations_run_
+                  << " iteraciones por isla\n";
+        std::cout << "\nFinal: " << best_score << " vertices, " << best_edges
+                  << " edges\n";
+    }
+    return colonies_[best_island()]->get_best_solution();
+}
+
+} // namespace mcs
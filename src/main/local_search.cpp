@@ -0,0 +1,290 @@
+#include "../include/local_search.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace mcs {
+
+// Tamaño máximo de las tablas Q y P
+static constexpr std::size_t TABLE_LIMIT_BYTES = std::size_t{64} << 20;
+
+// Pasos que un vértice quitado en una meseta no puede volver a entrar
+static constexpr int TABU_TENURE = 7;
+
+// Máximo de candidatos por conflicto que se combinan en el (1,2)-swap
+static constexpr std::size_t SWAP_GROUP_LIMIT = 64;
+
+// Ningún par sin conflictos en open_
+static constexpr std::size_t NO_PAIR = std::numeric_limits<std::size_t>::max();
+
+LocalSearch::LocalSearch(const Graph& g1, const Graph& g2)
+    : g1_(g1),
+      g2_(g2),
+      words_(words_for(g1.num_vertices())) {
+    const std::size_t n1 = g1.num_vertices();
+    const std::size_t n2 = g2.num_vertices();
+    const std::size_t pairs = n1 * n2;
+    const std::size_t per_pair = sizeof(std::uint16_t) + sizeof(char) +
+                                 sizeof(std::uint32_t) + sizeof(Candidate);
+    const std::size_t bytes = (n1 + n2) * words_ * sizeof(Word) + pairs * per_pair;
+    enabled_ = bytes <= TABLE_LIMIT_BYTES;
+    if (!enabled_) return;
+
+    q_.assign(n1 * words_, 0);
+    p_.assign(n2 * words_, 0);
+    conflicts_.assign(pairs, 0);
+    listed_.assign(pairs, 0);
+    near1_.assign(n1, 0);
+    near2_.assign(n2, 0);
+    tabu1_.assign(n1, 0);
+    tabu2_.assign(n2, 0);
+    best_.reset(n1, n2);
+
+    // Capacidad final de antemano: improve() no reserva memoria (cada par
+    // está a lo más una vez en open_)
+    free1_.reserve(n1);
+    free2_.reserve(n2);
+    open_.reserve(pairs);
+    candidates_.reserve(pairs);
+}
+
+void LocalSearch::rebuild(const Mapping& mapping) {
+    free1_.clear();
+    free2_.clear();
+    for (Vertex u = 0; u < static_cast<Vertex>(g1_.num_vertices()); ++u) {
+        if (!mapping.is_mapped_g1(u)) free1_.push_back(u);
+    }
+    for (Vertex v = 0; v < static_cast<Vertex>(g2_.num_vertices()); ++v) {
+        if (!mapping.is_mapped_g2(v)) free2_.push_back(v);
+    }
+
+    std::fill(q_.begin(), q_.end(), Word{0});
+    std::fill(p_.begin(), p_.end(), Word{0});
+    for (const auto& [x, y] : mapping.pairs()) {
+        const std::size_t w = static_cast<std::size_t>(x) / WORD_BITS;
+        const Word bit = Word{1} << (x % WORD_BITS);
+        g1_.for_each_neighbor(x, [&](Vertex u) {
+            q_[static_cast<std::size_t>(u) * words_ + w] |= bit;
+        });
+        g2_.for_each_neighbor(y, [&](Vertex v) {
+            p_[static_cast<std::size_t>(v) * words_ + w] |= bit;
+        });
+    }
+
+    // Conflictos de todos los pares, mapeados o no: los de un vértice que
+    // sale del mapeo ya están al día
+    const std::size_t n1 = g1_.num_vertices();
+    const std::size_t n2 = g2_.num_vertices();
+    for (std::size_t u = 0; u < n1; ++u) {
+        const Word* q = &q_[u * words_];
+        for (std::size_t v = 0; v < n2; ++v) {
+            const Word* p = &p_[v * words_];
+            int conflicts = 0;
+            for (std::size_t w = 0; w < words_; ++w) conflicts += popcount(q[w] ^ p[w]);
+            conflicts_[u * n2 + v] = static_cast<std::uint16_t>(conflicts);
+        }
+    }
+
+    open_.clear();
+    std::fill(listed_.begin(), listed_.end(), char{0});
+    for (Vertex u : free1_) {
+        for (Vertex v : free2_) list_pair(static_cast<std::size_t>(u) * n2 + v);
+    }
+}
+
+void LocalSearch::list_pair(std::size_t pair) {
+    if (conflicts_[pair] > 1 || listed_[pair]) return;
+    listed_[pair] = 1;
+    open_.push_back(static_cast<std::uint32_t>(pair));
+}
+
+void LocalSearch::flip_pair(Vertex x, Vertex y, int delta) {
+    const std::size_t n1 = g1_.num_vertices();
+    const std::size_t n2 = g2_.num_vertices();
+    const std::size_t w = static_cast<std::size_t>(x) / WORD_BITS;
+    const Word bit = Word{1} << (x % WORD_BITS);
+    g1_.for_each_neighbor(x, [&](Vertex u) {
+        q_[static_cast<std::size_t>(u) * words_ + w] ^= bit;
+        near1_[u] = 1;
+    });
+    g2_.for_each_neighbor(y, [&](Vertex v) {
+        p_[static_cast<std::size_t>(v) * words_ + w] ^= bit;
+        near2_[v] = 1;
+    });
+
+    // x es conflicto de (u, v) si solo uno de los dos es vecino de x o de
+    // y: O(deg(x) · n2 + deg(y) · n1). Un par que baja a <= 1 entra en
+    // open_; los que suben o se mapean se descartan al recorrerla
+    const auto shift = [&](std::size_t pair) {
+        conflicts_[pair] = static_cast<std::uint16_t>(conflicts_[pair] + delta);
+        list_pair(pair);
+    };
+    g1_.for_each_neighbor(x, [&](Vertex u) {
+        const std::size_t row = static_cast<std::size_t>(u) * n2;
+        for (std::size_t v = 0; v < n2; ++v) {
+            if (!near2_[v]) shift(row + v);
+        }
+    });
+    g2_.for_each_neighbor(y, [&](Vertex v) {
+        for (std::size_t u = 0; u < n1; ++u) {
+            if (!near1_[u]) shift(u * n2 + static_cast<std::size_t>(v));
+        }
+    });
+
+    g1_.for_each_neighbor(x, [&](Vertex u) { near1_[u] = 0; });
+    g2_.for_each_neighbor(y, [&](Vertex v) { near2_[v] = 0; });
+}
+
+// Las listas de libres se mantienen ordenadas: el recorrido de improve()
+// visita los pares en el mismo orden que si se reconstruyeran
+static void insert_sorted(std::vector<Vertex>& list, Vertex x) {
+    list.insert(std::lower_bound(list.begin(), list.end(), x), x);
+}
+
+static void erase_sorted(std::vector<Vertex>& list, Vertex x) {
+    list.erase(std::lower_bound(list.begin(), list.end(), x));
+}
+
+void LocalSearch::add_pair(Mapping& mapping, Vertex u, Vertex v) {
+    mapping.add_pair(u, v);
+    flip_pair(u, v, +1);
+    erase_sorted(free1_, u);
+    erase_sorted(free2_, v);
+}
+
+void LocalSearch::remove_pair(Mapping& mapping, Vertex x) {
+    const Vertex y = mapping.get_image(x);
+    mapping.remove_pair(x);
+    flip_pair(x, y, -1);
+    insert_sorted(free1_, x);
+    insert_sorted(free2_, y);
+
+    // Los pares de x y de y vuelven a ser libres
+    const std::size_t n2 = g2_.num_vertices();
+    for (Vertex v : free2_) list_pair(static_cast<std::size_t>(x) * n2 + v);
+    for (Vertex u : free1_) list_pair(static_cast<std::size_t>(u) * n2 + y);
+}
+
+Vertex LocalSearch::single_conflict(Vertex u, Vertex v) const {
+    const Word* q = &q_[static_cast<std::size_t>(u) * words_];
+    const Word* p = &p_[static_cast<std::size_t>(v) * words_];
+    std::size_t w = 0;
+    while ((q[w] ^ p[w]) == 0) ++w;
+    return static_cast<Vertex>(w * WORD_BITS + lowest_bit(q[w] ^ p[w]));
+}
+
+bool LocalSearch::try_swap_12(Mapping& mapping, int step) {
+    for (std::size_t begin = 0; begin < candidates_.size();) {
+        std::size_t end = begin;
+        while (end < candidates_.size() &&
+               candidates_[end].conflict == candidates_[begin].conflict) {
+            ++end;
+        }
+
+        const std::size_t last = std::min(end, begin + SWAP_GROUP_LIMIT);
+        for (std::size_t i = begin; i < last; ++i) {
+            const Candidate& a = candidates_[i];
+            for (std::size_t j = i + 1; j < last; ++j) {
+                const Candidate& b = candidates_[j];
+                if (a.u == b.u || a.v == b.v) continue;
+                if (g1_.edge(a.u, b.u) != g2_.edge(a.v, b.v)) continue;
+
+                const Vertex x = a.conflict;
+                const Vertex y = mapping.get_image(x);
+                remove_pair(mapping, x);
+                add_pair(mapping, a.u, a.v);
+                add_pair(mapping, b.u, b.v);
+                tabu1_[x] = step + TABU_TENURE;
+                tabu2_[y] = step + TABU_TENURE;
+                return true;
+            }
+        }
+        begin = end;
+    }
+    return false;
+}
+
+bool LocalSearch::improve(Mapping& mapping, int max_steps) {
+    if (!enabled_ || max_steps <= 0) return false;
+
+    const int start_size = mapping.size();
+    best_ = mapping;
+    std::fill(tabu1_.begin(), tabu1_.end(), 0);
+    std::fill(tabu2_.begin(), tabu2_.end(), 0);
+
+    // Tablas completas una vez; cada movimiento solo actualiza los vecinos
+    // de los vértices que entran o salen
+    rebuild(mapping);
+
+    const std::size_t n2 = g2_.num_vertices();
+    int idle = 0;
+    for (int step = 1; idle < max_steps; ++step) {
+        candidates_.clear();
+
+        // Depurar open_ (quedan los pares libres con <= 1 conflicto) y
+        // agregar el primer par sin conflictos, como al recorrer free1 × free2
+        std::size_t add = NO_PAIR;
+        std::size_t kept = 0;
+        for (const std::uint32_t pair : open_) {
+            const Vertex u = static_cast<Vertex>(pair / n2);
+            const Vertex v = static_cast<Vertex>(pair % n2);
+            if (conflicts_[pair] > 1 || mapping.is_mapped_g1(u) ||
+                mapping.is_mapped_g2(v)) {
+                listed_[pair] = 0;
+                continue;
+            }
+            open_[kept++] = pair;
+            if (conflicts_[pair] == 0) add = std::min<std::size_t>(add, pair);
+        }
+        open_.resize(kept);
+
+        bool added = add != NO_PAIR;
+        if (added) {
+            add_pair(mapping, static_cast<Vertex>(add / n2), static_cast<Vertex>(add % n2));
+        } else {
+            // Sin pares de 0 conflictos, todo open_ tiene exactamente uno
+            for (const std::uint32_t pair : open_) {
+                const Vertex u = static_cast<Vertex>(pair / n2);
+                const Vertex v = static_cast<Vertex>(pair % n2);
+                candidates_.push_back({u, v, single_conflict(u, v)});
+            }
+            std::sort(candidates_.begin(), candidates_.end(),
+                      [](const Candidate& a, const Candidate& b) {
+                          if (a.conflict != b.conflict) return a.conflict < b.conflict;
+                          if (a.u != b.u) return a.u < b.u;
+                          return a.v < b.v;
+                      });
+            added = try_swap_12(mapping, step);
+        }
+
+        // Las mesetas conservan el tamaño, así que agregar siempre mejora
+        if (added) {
+            best_ = mapping;
+            idle = 0;
+            continue;
+        }
+
+        // Meseta: (1,1)-swap con un candidato no tabú, rotando el inicio para
+        // no elegir siempre el mismo
+        const std::size_t count = candidates_.size();
+        bool moved = false;
+        for (std::size_t k = 0; k < count && !moved; ++k) {
+            const Candidate& c =
+                candidates_[(k + static_cast<std::size_t>(step) * 7919) % count];
+            if (tabu1_[c.u] >= step || tabu2_[c.v] >= step) continue;
+
+            const Vertex y = mapping.get_image(c.conflict);
+            remove_pair(mapping, c.conflict);
+            add_pair(mapping, c.u, c.v);
+            tabu1_[c.conflict] = step + TABU_TENURE;
+            tabu2_[y] = step + TABU_TENURE;
+            moved = true;
+        }
+        if (!moved) break;
+        ++idle;
+    }
+
+    mapping = best_;
+    return mapping.size() > start_size;
+}
+
+} // namespace mcs
@@ -1,30 +1,105 @@
 #include "../include/graph.hpp"
 #include "../include/reader.hpp"
-#include "../include/aco.hpp"
+#include "../include/mcs.hpp"
+#include "../include/batch.hpp"
 #include "../include/graphy.hpp"
+#include "../include/profile.hpp"
 #include <iostream>
 #include <iomanip>
 #include <string>
 #include <cstring>
+#include <csignal>
 #include <cstdlib>
+#include <memory>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 using namespace mcs;
 
+/**
+ * @brief Opciones de línea de comandos que no son parámetros del ACO.
+ */
+struct CliOptions {
+    std::string file1;
+    std::string file2;
+    std::string output_base;
+    GraphStorage storage = GraphStorage::Auto;
+    Solver solver = Solver::Aco;
+    int threads = 0;
+    IslandParams island_params;
+    bool use_islands = false;
+    // Modo por lotes: --batch <consulta> <objetivos> o --all-pairs <lista>
+    std::string batch_query;
+    std::string batch_list;
+    bool all_pairs = false;
+    std::string csv_path;
+    std::string matrix_path;
+    bool write_cache = false;
+    bool no_svg = false;
+    bool no_export = false;
+    bool quiet = false;
+    // Perfil de las rutas críticas (requiere compilar con -Dprofile=true)
+    bool profile = false;
+    std::string profile_json;
+    std::string telemetry_path;
+};
+
 void print_usage(const char* program_name) {
     std::cout << "Uso: " << program_name << " <gráfica1.txt> <gráfica2.txt> --seed <n> [opciones]\n\n";
     std::cout << "Argumentos obligatorios:\n";
     std::cout << "  <gráfica1.txt>      Archivo de la primera gráfica\n";
     std::cout << "  <gráfica2.txt>      Archivo de la segunda gráfica\n";
     std::cout << "  --seed <n>          Semilla aleatoria (OBLIGATORIO)\n\n";
+    std::cout << "Modo por lotes:\n";
+    std::cout << "  " << program_name << " --batch <consulta.txt> <objetivos> --seed <n> [opciones]\n";
+    std::cout << "  " << program_name << " --all-pairs <gráficas> --seed <n> [opciones]\n";
+    std::cout << "      <objetivos>/<gráficas>: directorio o lista con una ruta por línea\n";
+    std::cout << "  --csv <archivo>     Resultados CSV (default: salida estándar)\n";
+    std::cout << "  --matrix <archivo>  Matriz binaria de similitud (float32)\n\n";
     std::cout << "Opciones:\n";
+    std::cout << "  --solver <modo>     aco, exact (McSplit) o hybrid (ACO + exacto) (default: aco)\n";
+    std::cout << "  --threads <n>       Hilos de OpenMP (default: todos los disponibles)\n";
     std::cout << "  --ants <n>          Número de hormigas (default: 20)\n";
     std::cout << "  --iterations <n>    Iteraciones máximas (default: 100)\n";
     std::cout << "  --alpha <f>         Peso de feromona (default: 1.0)\n";
     std::cout << "  --beta <f>          Peso de heurística (default: 3.0)\n";
     std::cout << "  --rho <f>           Tasa de evaporación (default: 0.1)\n";
+    std::cout << "  --max-stagnation <n> Parar tras n iteraciones sin mejora (default: 0, desactivado)\n";
+    std::cout << "  --time-limit <seg>  Tiempo máximo de búsqueda (default: 0, sin límite);\n";
+    std::cout << "                      en modo hybrid se aplica a cada fase\n";
+    std::cout << "  --target-size <k>   Parar al encontrar k vértices (default: 0, desactivado)\n";
+    std::cout << "  --local-search <m>  Búsqueda local: none, best o all (default: none)\n";
+    std::cout << "  --local-search-steps <n>\n";
+    std::cout << "                      Pasos sin mejora de la búsqueda local (default: 50)\n";
+    std::cout << "  --mmas              MAX-MIN Ant System: feromonas acotadas y reinicios\n";
+    std::cout << "  --restart-cf <f>    Factor de convergencia que reinicia MMAS (default: 0.999)\n";
+    std::cout << "  --islands <n>       Colonias independientes con migración (default: 1)\n";
+    std::cout << "  --migration-interval <n>\n";
+    std::cout << "                      Iteraciones entre migraciones (default: 25)\n";
+    std::cout << "  --topology <t>      Islas: ring o full (default: ring)\n";
+    std::cout << "  --migration <m>     Islas: solution o pheromone (default: solution)\n";
+    std::cout << "  --blend <f>         Peso del emisor al mezclar feromonas (default: 0.1)\n";
+    std::cout << "  --eager-evaporation Evaporar toda la matriz en cada iteración\n";
+    std::cout << "                      (default: evaporación perezosa O(1))\n";
+    std::cout << "  --pheromone <modo>  Feromonas: dense, sparse o auto (default: auto)\n";
+    std::cout << "  --storage <modo>    Adyacencia: dense, sparse o auto (default: auto)\n";
+    std::cout << "  --cache             Guardar <gráfica>.mcsg (binario) para lecturas futuras;\n";
+    std::cout << "                      si existe y está al día se usa siempre\n";
     std::cout << "  --output <nombre>   Generar visualizaciones y exportar\n";
     std::cout << "                      Crea: <nombre>_g1.svg, <nombre>_g2.svg,\n";
     std::cout << "                            <nombre>_solucion.svg, <nombre>.mcis\n";
+    std::cout << "  --no-svg            No generar las visualizaciones SVG\n";
+    std::cout << "  --no-export         No escribir el archivo .mcis\n";
+    std::cout << "  --quiet             Solo imprimir la línea final (tamaño y aristas)\n";
+    std::cout << "  --telemetry <archivo>\n";
+    std::cout << "                      Estadísticas por iteración del ACO (.csv o NDJSON),\n";
+    std::cout << "                      escritas por un hilo aparte\n";
+    std::cout << "  --profile           Imprimir contadores y tiempos por fase al terminar\n";
+    std::cout << "  --profile-json <archivo>\n";
+    std::cout << "                      Escribir el mismo perfil en JSON\n";
+    std::cout << "                      (ambas requieren compilar con meson -Dprofile=true)\n";
     std::cout << "  --help, -h          Mostrar esta ayuda\n\n";
     std::cout << "Ejemplos:\n";
     std::cout << "  " << program_name << " g1.txt g2.txt --seed 42\n";
@@ -33,9 +108,7 @@ void print_usage(const char* program_name) {
     std::cout << "              resultado_solucion.svg, resultado.mcis\n";
 }
 
-ACOParams parse_arguments(int argc, char* argv[], 
-                         std::string& file1, std::string& file2,
-                         std::string& output_base) {
+ACOParams parse_arguments(int argc, char* argv[], CliOptions& opts) {
     ACOParams params;
     bool seed_provided = false;
 
@@ -44,10 +117,24 @@ ACOParams parse_arguments(int argc, char* argv[],
         std::exit(1);
     }
 
-    file1 = argv[1];
-    file2 = argv[2];
+    int first_option = 3;
+    if (std::strcmp(argv[1], "--batch") == 0) {
+        if (argc < 4) {
+            std::cerr << "Error: --batch requiere una consulta y los objetivos\n";
+            std::exit(1);
+        }
+        opts.batch_query = argv[2];
+        opts.batch_list = argv[3];
+        first_option = 4;
+    } else if (std::strcmp(argv[1], "--all-pairs") == 0) {
+        opts.batch_list = argv[2];
+        opts.all_pairs = true;
+    } else {
+        opts.file1 = argv[1];
+        opts.file2 = argv[2];
+    }
 
-    for (int i = 3; i < argc; i++) {
+    for (int i = first_option; i < argc; i++) {
         std::string arg = argv[i];
 
         if (arg == "--help" || arg == "-h") {
@@ -61,6 +148,28 @@ ACOParams parse_arguments(int argc, char* argv[],
                 std::cerr << "Error: --seed requiere un valor\n";
                 std::exit(1);
             }
+        } else if (arg == "--solver") {
+            if (i + 1 < argc) {
+                std::string mode = argv[++i];
+                if (mode == "aco") {
+                    opts.solver = Solver::Aco;
+                } else if (mode == "exact") {
+                    opts.solver = Solver::Exact;
+                } else if (mode == "hybrid") {
+                    opts.solver = Solver::Hybrid;
+                } else {
+                    std::cerr << "Error: --solver debe ser aco, exact o hybrid\n";
+                    std::exit(1);
+                }
+            }
+        } else if (arg == "--threads") {
+            if (i + 1 < argc) {
+                opts.threads = std::atoi(argv[++i]);
+                if (opts.threads <= 0) {
+                    std::cerr << "Error: --threads debe ser > 0\n";
+                    std::exit(1);
+                }
+            }
         } else if (arg == "--ants") {
             if (i + 1 < argc) {
                 params.num_ants = std::atoi(argv[++i]);
@@ -93,9 +202,183 @@ ACOParams parse_arguments(int argc, char* argv[],
                     std::exit(1);
                 }
             }
+        } else if (arg == "--max-stagnation") {
+            if (i + 1 < argc) {
+                params.max_stagnation = std::atoi(argv[++i]);
+                if (params.max_stagnation < 0) {
+                    std::cerr << "Error: --max-stagnation debe ser >= 0\n";
+                    std::exit(1);
+                }
+            }
+        } else if (arg == "--time-limit") {
+            if (i + 1 < argc) {
+                params.time_limit = std::atof(argv[++i]);
+                if (params.time_limit < 0) {
+                    std::cerr << "Error: --time-limit debe ser >= 0\n";
+                    std::exit(1);
+                }
+            }
+        } else if (arg == "--target-size") {
+            if (i + 1 < argc) {
+                params.target_size = std::atoi(argv[++i]);
+                if (params.target_size < 0) {
+                    std::cerr << "Error: --target-size debe ser >= 0\n";
+                    std::exit(1);
+                }
+            }
+        } else if (arg == "--local-search") {
+            if (i + 1 < argc) {
+                std::string mode = argv[++i];
+                if (mode == "none") {
+                    params.local_search = LocalSearchMode::None;
+                } else if (mode == "best") {
+                    params.local_search = LocalSearchMode::Best;
+                } else if (mode == "all") {
+                    params.local_search = LocalSearchMode::All;
+                } else {
+                    std::cerr << "Error: --local-search debe ser none, best o all\n";
+                    std::exit(1);
+                }
+            }
+        } else if (arg == "--local-search-steps") {
+            if (i + 1 < argc) {
+                params.local_search_steps = std::atoi(argv[++i]);
+                if (params.local_search_steps <= 0) {
+                    std::cerr << "Error: --local-search-steps debe ser > 0\n";
+                    std::exit(1);
+                }
+            }
+        } else if (arg == "--mmas") {
+            params.mmas = true;
+        } else if (arg == "--restart-cf") {
+            if (i + 1 < argc) {
+                params.restart_convergence = std::atof(argv[++i]);
+                if (params.restart_convergence <= 0) {
+                    std::cerr << "Error: --restart-cf debe ser > 0\n";
+                    std::exit(1);
+                }
+            }
+        } else if (arg == "--islands") {
+            if (i + 1 < argc) {
+                opts.island_params.islands = std::atoi(argv[++i]);
+                if (opts.island_params.islands <= 0) {
+                    std::cerr << "Error: --islands debe ser > 0\n";
+                    std::exit(1);
+                }
+                opts.use_islands = opts.island_params.islands > 1;
+            }
+        } else if (arg == "--migration-interval") {
+            if (i + 1 < argc) {
+                opts.island_params.migration_interval = std::atoi(argv[++i]);
+                if (opts.island_params.migration_interval <= 0) {
+                    std::cerr << "Error: --migration-interval debe ser > 0\n";
+                    std::exit(1);
+                }
+            }
+        } else if (arg == "--topology") {
+            if (i + 1 < argc) {
+                std::string mode = argv[++i];
+                if (mode == "ring") {
+                    opts.island_params.topology = Topology::Ring;
+                } else if (mode == "full") {
+                    opts.island_params.topology = Topology::Full;
+                } else {
+                    std::cerr << "Error: --topology debe ser ring o full\n";
+                    std::exit(1);
+                }
+            }
+        } else if (arg == "--migration") {
+            if (i + 1 < argc) {
+                std::string mode = argv[++i];
+                if (mode == "solution") {
+                    opts.island_params.migration = Migration::Solution;
+                } else if (mode == "pheromone") {
+                    opts.island_params.migration = Migration::Pheromone;
+                } else {
+                    std::cerr << "Error: --migration debe ser solution o pheromone\n";
+                    std::exit(1);
+                }
+            }
+        } else if (arg == "--blend") {
+            if (i + 1 < argc) {
+                opts.island_params.blend = std::atof(argv[++i]);
+                if (opts.island_params.blend < 0 || opts.island_params.blend > 1) {
+                    std::cerr << "Error: --blend debe estar en [0, 1]\n";
+                    std::exit(1);
+                }
+            }
+        } else if (arg == "--eager-evaporation") {
+            params.lazy_evaporation = false;
+        } else if (arg == "--pheromone") {
+            if (i + 1 < argc) {
+                std::string mode = argv[++i];
+                if (mode == "dense") {
+                    params.pheromone_storage = PheromoneStorage::Dense;
+                } else if (mode == "sparse") {
+                    params.pheromone_storage = PheromoneStorage::Sparse;
+                } else if (mode == "auto") {
+                    params.pheromone_storage = PheromoneStorage::Auto;
+                } else {
+                    std::cerr << "Error: --pheromone debe ser dense, sparse o auto\n";
+                    std::exit(1);
+                }
+            }
+        } else if (arg == "--storage") {
+            if (i + 1 < argc) {
+                std::string mode = argv[++i];
+                if (mode == "dense") {
+                    opts.storage = GraphStorage::Dense;
+                } else if (mode == "sparse") {
+                    opts.storage = GraphStorage::Sparse;
+                } else if (mode == "auto") {
+                    opts.storage = GraphStorage::Auto;
+                } else {
+                    std::cerr << "Error: --storage debe ser dense, sparse o auto\n";
+                    std::exit(1);
+                }
+            }
+        } else if (arg == "--no-svg") {
+            opts.no_svg = true;
+        } else if (arg == "--no-export") {
+            opts.no_export = true;
+        } else if (arg == "--quiet") {
+            opts.quiet = true;
+            params.verbose = false;
+        } else if (arg == "--telemetry") {
+            if (i + 1 < argc) {
+                opts.telemetry_path = argv[++i];
+            } else {
+                std::cerr << "Error: --telemetry requiere un archivo\n";
+                std::exit(1);
+            }
+        } else if (arg == "--profile") {
+            opts.profile = true;
+        } else if (arg == "--profile-json") {
+            if (i + 1 < argc) {
+                opts.profile_json = argv[++i];
+            } else {
+                std::cerr << "Error: --profile-json requiere un archivo\n";
+                std::exit(1);
+            }
+        } else if (arg == "--cache") {
+            opts.write_cache = true;
+        } else if (arg == "--csv") {
+            if (i + 1 < argc) {
+                opts.csv_path = argv[++i];
+            } else {
+                std::cerr << "Error: --csv requiere un archivo\n";
+                std::exit(1);
+            }
+        } else if (arg == "--matrix") {
+            if (i + 1 < argc) {
+                opts.matrix_path = argv[++i];
+            } else {
+                std::cerr << "Error: --matrix requiere un archivo\n";
+                std::exit(1);
+            }
         } else if (arg == "--output") {
             if (i + 1 < argc) {
-                output_base = argv[++i];
+                opts.output_base = argv[++i];
             } else {
                 std::cerr << "Error: --output requiere un nombre base\n";
                 std::exit(1);
@@ -109,6 +392,19 @@ ACOParams parse_arguments(int argc, char* argv[],
         std::exit(1);
     }
 
+    // Por lotes cada hilo resuelve un par con una sola colonia, y un único
+    // archivo de telemetría mezclaría todos los pares
+    if (!opts.batch_list.empty()) {
+        if (opts.use_islands) {
+            std::cerr << "Error: --islands no se admite con --batch ni --all-pairs\n";
+            std::exit(1);
+        }
+        if (!opts.telemetry_path.empty()) {
+            std::cerr << "Error: --telemetry no se admite con --batch ni --all-pairs\n";
+            std::exit(1);
+        }
+    }
+
     return params;
 }
 
@@ -122,9 +418,42 @@ void print_params(const ACOParams& params) {
     std::cout << "   Beta (η):     " << params.beta << "\n";
     std::cout << "   Rho (evap):   " << params.rho << "\n";
     std::cout << "   Semilla:      " << params.seed << " \n";
+    if (params.max_stagnation > 0) {
+        std::cout << "   Estancamiento: " << params.max_stagnation << " iteraciones\n";
+    }
+    if (params.time_limit > 0) {
+        std::cout << "   Tiempo máx.:  " << params.time_limit << " s\n";
+    }
+    if (params.target_size > 0) {
+        std::cout << "   Objetivo:     " << params.target_size << " vértices\n";
+    }
     std::cout << "═══════════════════════════════════════════════════════════\n\n";
 }
 
+// Ctrl-C detiene la búsqueda y se reporta lo mejor encontrado; un segundo
+// Ctrl-C termina el proceso como siempre
+static CancellationToken interrupt_token;
+
+extern "C" void handle_interrupt(int) {
+    interrupt_token.cancel();
+    std::signal(SIGINT, SIG_DFL);
+}
+
+/**
+ * @brief Emite el perfil pedido con --profile / --profile-json y devuelve 0.
+ */
+int finish_run(const CliOptions& opts) {
+    if (!opts.profile && opts.profile_json.empty()) return 0;
+    if (!profile::enabled()) {
+        std::cerr << "Aviso: binario sin instrumentación; "
+                     "recompilar con meson configure -Dprofile=true\n";
+    } else if (opts.profile) {
+        profile::print_report(std::cout);
+    }
+    if (!opts.profile_json.empty()) profile::write_json(opts.profile_json);
+    return 0;
+}
+
 /**
  * @brief Programa principal para encontrar la máxima subgráfica común inducida (MCIS) entre dos gráficas.
  *
@@ -132,21 +461,84 @@ void print_params(const ACOParams& params) {
  */
 int main(int argc, char* argv[]) {
     try {
-        std::string file1, file2, output_base;
-        ACOParams params = parse_arguments(argc, argv, file1, file2, output_base);
+        CliOptions opts;
+        ACOParams params = parse_arguments(argc, argv, opts);
+        const std::string& output_base = opts.output_base;
+
+#ifdef _OPENMP
+        if (opts.threads > 0) omp_set_num_threads(opts.threads);
+#endif
+
+        if (!opts.batch_list.empty()) {
+            BatchParams batch;
+            batch.solver = opts.solver;
+            batch.storage = opts.storage;
+            batch.csv_path = opts.csv_path;
+            batch.matrix_path = opts.matrix_path;
+            batch.write_cache = opts.write_cache;
+
+            BatchRunner runner(params, batch);
+            const std::vector<std::string> files = list_graph_files(opts.batch_list);
+            if (opts.all_pairs) {
+                runner.run_all_pairs(files);
+            } else {
+                runner.run_query(opts.batch_query, files);
+            }
+            return finish_run(opts);
+        }
 
         Reader reader1, reader2;
-        Graph g1 = reader1.read_graph(file1);
-        Graph g2 = reader2.read_graph(file2);
+        reader1.set_write_cache(opts.write_cache);
+        reader2.set_write_cache(opts.write_cache);
+        Graph g1 = reader1.read_graph(opts.file1, opts.storage);
+        Graph g2 = reader2.read_graph(opts.file2, opts.storage);
 
-        print_params(params);
+        if (!opts.quiet) print_params(params);
 
-        ACO aco(g1, g2, params);
-        Mapping solution = aco.solve();
+        std::unique_ptr<TelemetryWriter> telemetry;
+        if (!opts.telemetry_path.empty() && opts.solver != Solver::Exact) {
+            telemetry = std::make_unique<TelemetryWriter>(
+                opts.telemetry_path, TelemetryWriter::format_for(opts.telemetry_path));
+        }
+
+        SolveOptions solve_options;
+        solve_options.solver = opts.solver;
+        solve_options.aco = params;
+        solve_options.use_islands = opts.use_islands;
+        solve_options.islands = opts.island_params;
+        solve_options.telemetry = telemetry.get();
+        solve_options.cancel = &interrupt_token;
+        std::signal(SIGINT, handle_interrupt);
+        const SolveResult result = solve(g1, g2, solve_options);
+        std::signal(SIGINT, SIG_DFL);
+        const Mapping& solution = result.mapping;
+
+        if (telemetry) {
+            if (!telemetry->close()) {
+                std::cerr << "Aviso: error al escribir " << opts.telemetry_path << "\n";
+            } else if (telemetry->dropped() > 0) {
+                std::cerr << "Aviso: telemetría incompleta, " << telemetry->dropped()
+                          << " registros descartados\n";
+            }
+        }
+
+        if (opts.solver != Solver::Aco && !opts.quiet) {
+            std::cout << "\nExacto (McSplit)\n";
+            std::cout << "Nodos: " << result.exact_nodes << "\n";
+            std::cout << "Óptimo: " << (result.optimal ? "sí" : "no (límite de tiempo)")
+                      << "\n";
+            std::cout << "Final: " << result.size << " vertices, " << result.edges
+                      << " edges\n";
+        }
+
+        if (opts.quiet) {
+            std::cout << "Final: " << result.size << " vertices, " << result.edges
+                      << " edges\n";
+        }
 
         if (solution.size() == 0) {
-            std::cout << "Mapeo: (vacío - no se encontró subgrafica común)\n\n";
-            return 0;
+            if (!opts.quiet) std::cout << "Mapeo: (vacío - no se encontró subgrafica común)\n\n";
+            return finish_run(opts);
         }
 
         // Mostrar mapeo        
@@ -154,21 +546,29 @@ int main(int argc, char* argv[]) {
         const auto& names2 = reader2.id_to_name();
 
         // Mostrar mapeo encontrado
-        int shown = 0;
-        for (const auto& [u, v] : solution.get_nodes_vector()) {
-            std::cout << "   " << std::setw(15) << std::left << names1[u]
-                      << " → " << names2[v] << "\n";
-            shown++;
+        if (!opts.quiet) {
+            for (const auto& [u, v] : solution.pairs()) {
+                std::cout << "   " << std::setw(15) << std::left << names1[u]
+                          << " → " << names2[v] << "\n";
+            }
         }
 
         /**
-         * Exporta siempre la MCIS como archivo, usando el nombre base o uno por defecto.
+         * Exporta la MCIS como archivo (salvo --no-export), usando el nombre base o uno por defecto.
          */
-        std::string mcis_file = output_base.empty() ? "resultado.mcis" : output_base + ".mcis";
-        solution.export_mcis(g1, g2, names1, names2, mcis_file);
+        if (!opts.no_export) {
+            std::string mcis_file = output_base.empty() ? "resultado.mcis" : output_base + ".mcis";
+            if (solution.export_mcis(g1, g2, names1, names2, mcis_file) && !opts.quiet) {
+                std::cout << "[Export] MCIS guardado en: " << mcis_file << "\n";
+                std::cout << "         Vértices: " << solution.size()
+                          << ", Aristas: " << result.edges << "\n";
+            }
+        }
+
+        if (opts.no_svg) return finish_run(opts);
 
         /**
-         * Genera siempre visualizaciones SVG de ambas gráficas y la solución MCIS.
+         * Genera visualizaciones SVG de ambas gráficas y la solución MCIS (salvo --no-svg).
          * Si no se especifica --output, usa nombres por defecto.
          */
         std::string svg_g1 = output_base.empty() ? "resultado_g1.svg" : output_base + "_g1.svg";
@@ -203,7 +603,7 @@ int main(int argc, char* argv[]) {
         viz_solucion.dibujaSubgraficaInducidaCircular(subset_g1, svg_solucion);
 
 
-        return 0;
+        return finish_run(opts);
 
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << "\n";
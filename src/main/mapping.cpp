@@ -1,116 +1,209 @@
 #include "../include/mapping.hpp"
 #include "../include/graph.hpp"
-#include <fstream>
+#include "../include/buffered_writer.hpp"
+#include "../include/profile.hpp"
 #include <iostream>
 #include <algorithm>
 
 namespace mcs {
 
+Mapping::Mapping(std::size_t n1, std::size_t n2)
+    : image_(n1, -1),
+      preimage_(n2, -1),
+      mask_g1_(words_for(n1), 0),
+      mask_g2_(words_for(n2), 0) {
+    // Un mapeo inyectivo tiene a lo más min(n1, n2) pares: add_pair no reserva
+    pairs_.reserve(std::min(n1, n2));
+}
+
 bool Mapping::is_mapped_g1(Vertex u) const {
-    return mapping_.find(u) != mapping_.end();
+    return static_cast<std::size_t>(u) < image_.size() && image_[u] >= 0;
 }
 
 bool Mapping::is_mapped_g2(Vertex v) const {
-    return mapped_g2_.find(v) != mapped_g2_.end();
+    return static_cast<std::size_t>(v) < preimage_.size() && preimage_[v] >= 0;
 }
 
 Vertex Mapping::get_image(Vertex u) const {
-    auto it = mapping_.find(u);
-    return (it != mapping_.end()) ? it->second : -1;
+    return static_cast<std::size_t>(u) < image_.size() ? image_[u] : -1;
+}
+
+// ============================================================================
+// FACTIBILIDAD (palabra a palabra o por lista de vecinos)
+// ============================================================================
+// Como el mapeo es biyectivo entre los mapeados de g1 y g2, (u,v) es factible
+// si cada vecino mapeado de u tiene su imagen adyacente a v y ambos tienen el
+// mismo número de vecinos mapeados. Con almacenamiento denso ambos conteos
+// salen de AND + popcount; con CSR se recorre la lista de vecinos.
+static inline bool in_mask(const std::vector<Word>& mask, Vertex x) {
+    const std::size_t w = static_cast<std::size_t>(x) / WORD_BITS;
+    return w < mask.size() && ((mask[w] >> (x % WORD_BITS)) & 1u);
+}
+
+static int count_mapped_neighbors(const Graph& g, Vertex x,
+                                  const std::vector<Word>& mask) {
+    int count = 0;
+    if (g.is_dense()) {
+        const Word* row = g.row(x);
+        const std::size_t words = std::min(g.words_per_row(), mask.size());
+        for (std::size_t w = 0; w < words; ++w) {
+            count += popcount(row[w] & mask[w]);
+        }
+    } else {
+        for (Vertex y : g.neighbors(x)) count += in_mask(mask, y);
+    }
+    return count;
+}
+
+// Recorre los vecinos de x presentes en mask; f devuelve false para cortar.
+// Devuelve el número de vecinos visitados.
+template <class F>
+static int for_each_mapped_neighbor(const Graph& g, Vertex x,
+                                    const std::vector<Word>& mask, F&& f) {
+    int visited = 0;
+    if (g.is_dense()) {
+        const Word* row = g.row(x);
+        const std::size_t words = std::min(g.words_per_row(), mask.size());
+        for (std::size_t w = 0; w < words; ++w) {
+            for (Word bits = row[w] & mask[w]; bits; bits &= bits - 1) {
+                ++visited;
+                if (!f(static_cast<Vertex>(w * WORD_BITS + lowest_bit(bits)))) {
+                    return -1;
+                }
+            }
+        }
+    } else {
+        for (Vertex y : g.neighbors(x)) {
+            if (!in_mask(mask, y)) continue;
+            ++visited;
+            if (!f(y)) return -1;
+        }
+    }
+    return visited;
 }
 
 bool Mapping::is_feasible_add(Vertex u, Vertex v,
                               const Graph& g1,
                               const Graph& g2) const {
-    for (const auto& [u2, v2] : mapping_) {
-        if (g1.edge(u, u2) != g2.edge(v, v2)) {
-            return false;
-        }
-    }
-    return true;
+    MCS_PROFILE_COUNT(FeasibilityChecks);
+    const int neighbors1 = for_each_mapped_neighbor(
+        g1, u, mask_g1_,
+        [&](Vertex um) { return g2.edge(v, get_image(um)); });
+
+    return neighbors1 >= 0 &&
+           neighbors1 == count_mapped_neighbors(g2, v, mask_g2_);
+}
+
+static inline void set_bit(std::vector<Word>& mask, Vertex x) {
+    const std::size_t w = static_cast<std::size_t>(x) / WORD_BITS;
+    if (w >= mask.size()) mask.resize(w + 1, 0);
+    mask[w] |= Word{1} << (x % WORD_BITS);
+}
+
+static inline void clear_bit(std::vector<Word>& mask, Vertex x) {
+    const std::size_t w = static_cast<std::size_t>(x) / WORD_BITS;
+    if (w < mask.size()) mask[w] &= ~(Word{1} << (x % WORD_BITS));
 }
 
 void Mapping::add_pair(Vertex u, Vertex v) {
-    mapping_[u] = v;
-    mapped_g2_.insert(v);
+    if (static_cast<std::size_t>(u) >= image_.size()) image_.resize(u + 1, -1);
+    if (static_cast<std::size_t>(v) >= preimage_.size()) preimage_.resize(v + 1, -1);
+
+    if (image_[u] >= 0) remove_pair(u);
+    if (preimage_[v] >= 0) remove_pair(preimage_[v]);
+
+    image_[u] = v;
+    preimage_[v] = u;
+    pairs_.emplace_back(u, v);
+    set_bit(mask_g1_, u);
+    set_bit(mask_g2_, v);
 }
 
 void Mapping::remove_pair(Vertex u) {
-    auto it = mapping_.find(u);
-    if (it == mapping_.end()) return;
+    if (!is_mapped_g1(u)) return;
 
-    mapped_g2_.erase(it->second);
-    mapping_.erase(it);
+    const Vertex v = image_[u];
+    image_[u] = -1;
+    preimage_[v] = -1;
+    clear_bit(mask_g1_, u);
+    clear_bit(mask_g2_, v);
+
+    // Conserva el orden de inserción del resto de los pares
+    pairs_.erase(std::find(pairs_.begin(), pairs_.end(), std::make_pair(u, v)));
 }
 
 int Mapping::size() const {
-    return static_cast<int>(mapping_.size());
+    return static_cast<int>(pairs_.size());
 }
 
 int Mapping::count_edges(const Graph& g1, const Graph& g2) const {
+    // Cada arista (u1,u2) se cuenta una vez, desde el extremo menor, recorriendo
+    // solo los vecinos mapeados de u1 en lugar de todos los pares del mapeo
     int count = 0;
-    auto nodes = get_nodes_vector();
-
-    for (std::size_t i = 0; i < nodes.size(); ++i) {
-        for (std::size_t j = i + 1; j < nodes.size(); ++j) {
-            const auto& [u1, v1] = nodes[i];
-            const auto& [u2, v2] = nodes[j];
-
-            if (g1.edge(u1, u2) && g2.edge(v1, v2)) {
-                ++count;
-            }
-        }
+    for (const auto& [u1, v1] : pairs_) {
+        for_each_mapped_neighbor(g1, u1, mask_g1_, [&](Vertex u2) {
+            if (u2 > u1 && g2.edge(v1, image_[u2])) ++count;
+            return true;
+        });
     }
-
     return count;
 }
 
 std::vector<std::pair<Vertex, Vertex>> Mapping::get_nodes_vector() const {
-    std::vector<std::pair<Vertex, Vertex>> result;
-    result.reserve(mapping_.size());
-    for (const auto& kv : mapping_) {
-        result.emplace_back(kv.first, kv.second);
-    }
-    return result;
+    return pairs_;
 }
 
 void Mapping::clear() {
-    mapping_.clear();
-    mapped_g2_.clear();
+    // O(|M|): solo se limpian las entradas usadas
+    for (const auto& [u, v] : pairs_) {
+        image_[u] = -1;
+        preimage_[v] = -1;
+        clear_bit(mask_g1_, u);
+        clear_bit(mask_g2_, v);
+    }
+    pairs_.clear();
 }
 
-// ============================================================================
-// NUEVA FUNCIÓN: EXPORTAR MCIS
-// ============================================================================
-void Mapping::export_mcis(const Graph& g1,
-                         const Graph& g2,
-                         const std::vector<std::string>& names1,
-                         const std::vector<std::string>& names2,
-                         const std::string& filename) const {
-    if (mapping_.empty()) {
-        std::cout << "[Export] Mapeo vacío, no se genera archivo .mcis\n";
+void Mapping::reset(std::size_t n1, std::size_t n2) {
+    if (image_.size() != n1 || preimage_.size() != n2) {
+        image_.assign(n1, -1);
+        preimage_.assign(n2, -1);
+        mask_g1_.assign(words_for(n1), 0);
+        mask_g2_.assign(words_for(n2), 0);
+        pairs_.clear();
+        pairs_.reserve(std::min(n1, n2));
         return;
     }
+    clear();
+}
 
-    std::ofstream out(filename);
-    if (!out) {
+// ============================================================================
+// NUEVA FUNCIÓN: EXPORTAR MCIS
+// ============================================================================
+bool Mapping::export_mcis(const Graph& g1,
+                          const Graph& g2,
+                          const std::vector<std::string>& names1,
+                          const std::vector<std::string>& names2,
+                          const std::string& filename) const {
+    if (pairs_.empty()) return false;
+    MCS_PROFILE_PHASE(Export);
+
+    BufferedWriter out(filename);
+    if (!out.is_open()) {
         std::cerr << "[Export] Error: no se pudo crear " << filename << "\n";
-        return;
+        return false;
     }
 
-    // Calcular número de aristas
-    int num_edges = count_edges(g1, g2);
-
     // Escribir encabezado
     out << "# Maximum Common Induced Subgraph (MCIS)\n";
-    out << "# Vertices: " << mapping_.size() << "\n";
-    out << "# Edges: " << num_edges << "\n";
+    out << "# Vertices: " << pairs_.size() << "\n";
+    out << "# Edges: " << count_edges(g1, g2) << "\n";
     out << "#\n";
     out << "# Format: Combined vertex names (g1|g2) followed by edge list\n";
     out << "#\n\n";
 
     // Obtener nodos ordenados
-    auto nodes = get_nodes_vector();
+    auto nodes = pairs_;
     std::sort(nodes.begin(), nodes.end());
 
     // Crear nombres combinados
@@ -120,41 +213,39 @@ void Mapping::export_mcis(const Graph& g1,
     out << "# === VERTEX MAPPING ===\n";
     for (size_t i = 0; i < nodes.size(); ++i) {
         const auto& [u, v] = nodes[i];
-        
-        std::string name_u = (u >= 0 && u < static_cast<int>(names1.size())) 
+
+        std::string name_u = (u >= 0 && u < static_cast<int>(names1.size()))
                             ? names1[u] : std::to_string(u);
-        std::string name_v = (v >= 0 && v < static_cast<int>(names2.size())) 
+        std::string name_v = (v >= 0 && v < static_cast<int>(names2.size()))
                             ? names2[v] : std::to_string(v);
-        
-        std::string combined = name_u + "|" + name_v;
-        combined_names.push_back(combined);
-        
-        out << "# " << i << ": " << combined << "\n";
+
+        combined_names.push_back(name_u + "|" + name_v);
+        out << "# " << i << ": " << combined_names.back() << "\n";
     }
     out << "\n";
 
-    // Escribir aristas
+    // Escribir aristas: los vecinos mapeados de u1 salen en orden creciente,
+    // igual que los nodos ordenados, así que el orden es el de los pares (i, j)
     out << "# === EDGES ===\n";
-    int edge_count = 0;
-    
     for (size_t i = 0; i < nodes.size(); ++i) {
-        for (size_t j = i + 1; j < nodes.size(); ++j) {
-            const auto& [u1, v1] = nodes[i];
-            const auto& [u2, v2] = nodes[j];
-
-            // Verificar que la arista existe en ambos graficas (MCIS inducido)
-            if (g1.edge(u1, u2) && g2.edge(v1, v2)) {
-                out << combined_names[i] << " " << combined_names[j] << "\n";
-                edge_count++;
+        const auto& [u1, v1] = nodes[i];
+        for_each_mapped_neighbor(g1, u1, mask_g1_, [&](Vertex u2) {
+            // Verificar que la arista existe en ambas gráficas (MCIS inducido)
+            if (u2 > u1 && g2.edge(v1, image_[u2])) {
+                const auto j = std::lower_bound(nodes.begin(), nodes.end(),
+                                                std::make_pair(u2, Vertex{-1})) -
+                               nodes.begin();
+                out << combined_names[i] << ' ' << combined_names[j] << '\n';
             }
-        }
+            return true;
+        });
     }
 
-    out.close();
-
-    std::cout << "[Export] MCIS guardado en: " << filename << "\n";
-    std::cout << "         Vértices: " << mapping_.size() 
-              << ", Aristas: " << edge_count << "\n";
+    if (!out.close()) {
+        std::cerr << "[Export] Error al escribir " << filename << "\n";
+        return false;
+    }
+    return true;
 }
 
-} // namespace mcs
\ No newline at end of file
+} // namespace mcs
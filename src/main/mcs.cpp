@@ -0,0 +1,93 @@
+#include "../include/mcs.hpp"
+#include "../include/mcsplit.hpp"
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace mcs {
+
+Graph make_graph(const EdgeArray& in, GraphStorage storage) {
+    if (in.num_edges > 0 && (!in.sources || !in.targets)) {
+        throw std::invalid_argument("EdgeArray sin arreglos de aristas");
+    }
+
+    const auto n = static_cast<long long>(in.num_vertices);
+    std::vector<std::pair<Graph::Vertex, Graph::Vertex>> edges(in.num_edges);
+    for (std::size_t i = 0; i < in.num_edges; ++i) {
+        const Graph::Vertex u = in.sources[i];
+        const Graph::Vertex v = in.targets[i];
+        if (u < 0 || v < 0 || u >= n || v >= n) {
+            throw std::invalid_argument("Arista " + std::to_string(i) + " fuera de rango: (" +
+                                        std::to_string(u) + ", " + std::to_string(v) + ")");
+        }
+        edges[i] = {u, v};
+    }
+    return Graph(in.num_vertices, edges, storage);
+}
+
+SolveResult solve(const Graph& g1, const Graph& g2, const SolveOptions& options) {
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point start = Clock::now();
+    SolveResult result;
+
+    if (options.solver != Solver::Exact && options.use_islands) {
+        IslandModel model(g1, g2, options.aco, options.islands);
+        model.set_progress(options.progress);
+        model.set_telemetry(options.telemetry);
+        model.set_cancellation(options.cancel);
+        model.set_anytime(options.anytime);
+        result.mapping = model.solve();
+        result.iterations = model.get_iterations_run();
+        result.cancelled = model.was_cancelled();
+    } else if (options.solver != Solver::Exact) {
+        ACO aco(g1, g2, options.aco);
+        aco.set_progress(options.progress);
+        aco.set_telemetry(options.telemetry);
+        aco.set_cancellation(options.cancel);
+        aco.set_anytime(options.anytime);
+        result.mapping = aco.solve();
+        result.iterations = aco.get_iterations_run();
+        result.cancelled = aco.was_cancelled();
+    }
+
+    if (options.solver != Solver::Aco && !result.cancelled) {
+        McSplit exact(g1, g2);
+        exact.set_time_limit(options.aco.time_limit);
+        exact.set_threads(options.aco.num_threads);
+        exact.set_cancellation(options.cancel);
+        if (options.solver == Solver::Hybrid) {
+            // La solución del ACO es la cota inferior inicial
+            exact.set_incumbent(result.mapping);
+        }
+        result.mapping = exact.solve();
+        result.exact_nodes = exact.nodes();
+        result.optimal = exact.is_optimal();
+        result.cancelled = !result.optimal && options.cancel && options.cancel->is_cancelled();
+    }
+
+    result.size = result.mapping.size();
+    result.edges = result.mapping.count_edges(g1, g2);
+    if (options.anytime && options.solver != Solver::Aco) {
+        auto snapshot = std::make_shared<SolutionSnapshot>();
+        snapshot->mapping = result.mapping;
+        snapshot->size = result.size;
+        snapshot->edges = result.edges;
+        snapshot->iteration = -1;
+        options.anytime->offer(std::move(snapshot));
+    }
+    const auto bound = std::min(g1.num_vertices(), g2.num_vertices());
+    result.optimal = result.optimal || static_cast<std::size_t>(result.size) >= bound;
+    result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return result;
+}
+
+SolveResult solve(const EdgeArray& g1, const EdgeArray& g2,
+                  const SolveOptions& options, GraphStorage storage) {
+    return solve(make_graph(g1, storage), make_graph(g2, storage), options);
+}
+
+} // namespace mcs
@@ -0,0 +1,310 @@
+#include "../include/mcsplit.hpp"
+#include <algorithm>
+#include <numeric>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace mcs {
+
+// Cada cuántos nodos se consulta el reloj
+static constexpr std::uint64_t TIME_CHECK_INTERVAL = 1024;
+
+static int thread_id() {
+#ifdef _OPENMP
+    return omp_get_thread_num();
+#else
+    return 0;
+#endif
+}
+
+// Vértices ordenados por grado descendente (empates por índice)
+static std::vector<Vertex> degree_order(const Graph& g) {
+    std::vector<Vertex> order(g.num_vertices());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](Vertex a, Vertex b) {
+        return g.degree(a) > g.degree(b);
+    });
+    return order;
+}
+
+// Mueve al inicio de arr[start, start + len) los elementos NO adyacentes a v;
+// devuelve cuántos son
+static int partition_by_adjacency(std::vector<int>& arr, int start, int len,
+                                  const Graph& g,
+                                  const std::vector<Vertex>& order, int v) {
+    const Vertex gv = order[v];
+    int split = start;
+    for (int j = start; j < start + len; ++j) {
+        if (!g.edge(gv, order[arr[j]])) {
+            std::swap(arr[split], arr[j]);
+            ++split;
+        }
+    }
+    return split - start;
+}
+
+// Posición del menor valor de arr[start, start + len) que sea mayor que w
+static int index_of_next_smallest(const std::vector<int>& arr, int start,
+                                  int len, int w) {
+    int idx = -1;
+    int smallest = -1;
+    for (int i = 0; i < len; ++i) {
+        const int x = arr[start + i];
+        if (x > w && (idx == -1 || x < smallest)) {
+            smallest = x;
+            idx = i;
+        }
+    }
+    return idx;
+}
+
+McSplit::McSplit(const Graph& g1, const Graph& g2)
+    : g1_(g1),
+      g2_(g2),
+      order1_(degree_order(g1)),
+      order2_(degree_order(g2)) {}
+
+void McSplit::set_incumbent(const Mapping& mapping) {
+    std::vector<int> rank1(g1_.num_vertices()), rank2(g2_.num_vertices());
+    for (std::size_t i = 0; i < order1_.size(); ++i) rank1[order1_[i]] = static_cast<int>(i);
+    for (std::size_t i = 0; i < order2_.size(); ++i) rank2[order2_[i]] = static_cast<int>(i);
+
+    incumbent_.clear();
+    for (const auto& [u, v] : mapping.pairs()) {
+        incumbent_.emplace_back(rank1[u], rank2[v]);
+    }
+    incumbent_size_.store(static_cast<int>(incumbent_.size()));
+}
+
+Mapping McSplit::solve() {
+    const int n1 = static_cast<int>(g1_.num_vertices());
+    const int n2 = static_cast<int>(g2_.num_vertices());
+
+    // Una sola clase inicial: los lazos no cuentan para la condición de
+    // inducida, igual que en Mapping::is_feasible_add y scripts/check.py
+    Subproblem root;
+    root.left.resize(static_cast<std::size_t>(n1));
+    root.right.resize(static_cast<std::size_t>(n2));
+    std::iota(root.left.begin(), root.left.end(), 0);
+    std::iota(root.right.begin(), root.right.end(), 0);
+    if (n1 > 0 && n2 > 0) root.domains.push_back({0, 0, n1, n2});
+
+#ifdef _OPENMP
+    const int threads = threads_ > 0 ? threads_ : omp_get_max_threads();
+#else
+    const int threads = 1;
+#endif
+
+    // Un estado por hilo; cada nivel empareja una pareja más, así que bastan
+    // min(n1, n2) + 2 niveles
+    const std::size_t levels = static_cast<std::size_t>(std::min(n1, n2)) + 2;
+    workers_.assign(static_cast<std::size_t>(threads), Worker{});
+    for (Worker& w : workers_) {
+        w.left.reserve(n1);
+        w.right.reserve(n2);
+        w.domains.assign(levels, {});
+        w.current.reserve(std::min(n1, n2));
+    }
+
+    incumbent_size_.store(static_cast<int>(incumbent_.size()));
+    timed_out_.store(false);
+    start_ = std::chrono::steady_clock::now();
+
+    if (threads == 1) {
+        // Sin equipo propio: omp_get_thread_num() sería el del llamador (por
+        // ejemplo un hilo del modo por lotes), así que se usa el estado 0
+        run_subproblem(root, workers_[0]);
+    } else {
+        #pragma omp parallel num_threads(threads)
+        #pragma omp single
+        expand(root);
+    }
+
+    nodes_ = 0;
+    for (const Worker& w : workers_) nodes_ += w.nodes;
+    optimal_ = !timed_out_.load();
+
+    Mapping result(g1_.num_vertices(), g2_.num_vertices());
+    for (const auto& [a, b] : incumbent_) {
+        result.add_pair(order1_[a], order2_[b]);
+    }
+    return result;
+}
+
+bool McSplit::out_of_time(std::uint64_t nodes) {
+    if (timed_out_.load(std::memory_order_relaxed)) return true;
+    if (nodes % TIME_CHECK_INTERVAL != 0) return false;
+
+    bool stop = cancel_ && cancel_->is_cancelled();
+    if (!stop && time_limit_ > 0.0) {
+        const std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start_;
+        stop = elapsed.count() >= time_limit_;
+    }
+    if (!stop) return false;
+    timed_out_.store(true, std::memory_order_relaxed);
+    return true;
+}
+
+void McSplit::offer(const std::vector<Pair>& current) {
+    const int size = static_cast<int>(current.size());
+    if (size <= incumbent_size_.load(std::memory_order_relaxed)) return;
+
+    std::lock_guard<std::mutex> lock(incumbent_mutex_);
+    if (size > static_cast<int>(incumbent_.size())) {
+        incumbent_ = current;
+        incumbent_size_.store(size, std::memory_order_relaxed);
+    }
+}
+
+int McSplit::bound(const std::vector<Bidomain>& domains) {
+    int total = 0;
+    for (const Bidomain& bd : domains) {
+        total += std::min(bd.left_len, bd.right_len);
+    }
+    return total;
+}
+
+// La clase con el lado mayor más pequeño (menos ramas); empates por el
+// vértice de mayor grado
+int McSplit::select_bidomain(const std::vector<Bidomain>& domains,
+                             const std::vector<int>& left) {
+    int best = -1;
+    int best_size = 0;
+    int best_vertex = 0;
+    for (std::size_t i = 0; i < domains.size(); ++i) {
+        const Bidomain& bd = domains[i];
+        const int size = std::max(bd.left_len, bd.right_len);
+        const int vertex = *std::min_element(left.begin() + bd.l,
+                                             left.begin() + bd.l + bd.left_len);
+        if (best == -1 || size < best_size ||
+            (size == best_size && vertex < best_vertex)) {
+            best = static_cast<int>(i);
+            best_size = size;
+            best_vertex = vertex;
+        }
+    }
+    return best;
+}
+
+void McSplit::filter_domains(const std::vector<Bidomain>& in,
+                             std::vector<Bidomain>& out,
+                             std::vector<int>& left, std::vector<int>& right,
+                             int v, int w) const {
+    out.clear();
+    for (const Bidomain& bd : in) {
+        const int left_na =
+            partition_by_adjacency(left, bd.l, bd.left_len, g1_, order1_, v);
+        const int right_na =
+            partition_by_adjacency(right, bd.r, bd.right_len, g2_, order2_, w);
+        const int left_a = bd.left_len - left_na;
+        const int right_a = bd.right_len - right_na;
+
+        if (left_na > 0 && right_na > 0) {
+            out.push_back({bd.l, bd.r, left_na, right_na});
+        }
+        if (left_a > 0 && right_a > 0) {
+            out.push_back({bd.l + left_na, bd.r + right_na, left_a, right_a});
+        }
+    }
+}
+
+template <class Branch>
+void McSplit::branch_loop(std::vector<Bidomain>& domains,
+                          std::vector<int>& left, std::vector<int>& right,
+                          const std::vector<Pair>& current,
+                          std::uint64_t& nodes, Branch&& branch) {
+    // Cada vuelta del ciclo es un nodo; la rama "v queda sin pareja" reutiliza
+    // el mismo nivel en lugar de recursar
+    for (;;) {
+        ++nodes;
+        if (out_of_time(nodes)) return;
+
+        offer(current);
+
+        const int size = static_cast<int>(current.size());
+        if (size + bound(domains) <= incumbent_size_.load(std::memory_order_relaxed)) {
+            return;
+        }
+
+        const int bd_idx = select_bidomain(domains, left);
+        if (bd_idx < 0) return;
+
+        // v: vértice de mayor grado de la clase; se saca del rango izquierdo
+        Bidomain& bd = domains[bd_idx];
+        const int v_pos = static_cast<int>(
+            std::min_element(left.begin() + bd.l,
+                             left.begin() + bd.l + bd.left_len) - left.begin());
+        const int v = left[v_pos];
+        --bd.left_len;
+        std::swap(left[v_pos], left[bd.l + bd.left_len]);
+
+        // Probar cada w de la clase, en orden de grado descendente
+        --bd.right_len;
+        int w = -1;
+        for (int i = 0; i <= bd.right_len; ++i) {
+            const int idx = index_of_next_smallest(right, bd.r, bd.right_len + 1, w);
+            w = right[bd.r + idx];
+            std::swap(right[bd.r + idx], right[bd.r + bd.right_len]);
+
+            branch(v, w);
+            if (timed_out_.load(std::memory_order_relaxed)) return;
+        }
+        ++bd.right_len;
+
+        if (bd.left_len == 0) {
+            domains[bd_idx] = domains.back();
+            domains.pop_back();
+        }
+    }
+}
+
+void McSplit::search(Worker& w, std::size_t depth) {
+    std::vector<Bidomain>& domains = w.domains[depth];
+    branch_loop(domains, w.left, w.right, w.current, w.nodes,
+                [&](int v, int u) {
+                    filter_domains(domains, w.domains[depth + 1], w.left, w.right, v, u);
+                    w.current.emplace_back(v, u);
+                    search(w, depth + 1);
+                    w.current.pop_back();
+                });
+}
+
+void McSplit::run_subproblem(const Subproblem& node, Worker& w) {
+    w.left = node.left;
+    w.right = node.right;
+    w.domains[node.depth] = node.domains;
+    w.current = node.current;
+    search(w, node.depth);
+}
+
+void McSplit::expand(Subproblem& node) {
+    std::uint64_t nodes = 0;
+    branch_loop(node.domains, node.left, node.right, node.current, nodes,
+                [&](int v, int u) {
+                    Subproblem child;
+                    child.left = node.left;
+                    child.right = node.right;
+                    filter_domains(node.domains, child.domains, child.left,
+                                   child.right, v, u);
+                    child.current = node.current;
+                    child.current.emplace_back(v, u);
+                    child.depth = node.depth + 1;
+
+                    #pragma omp task firstprivate(child)
+                    {
+                        if (child.depth < SPLIT_DEPTH) {
+                            expand(child);
+                        } else {
+                            // Dentro de search no hay puntos de planificación de
+                            // tareas, así que nadie más usa el estado de este hilo
+                            run_subproblem(child, workers_[thread_id()]);
+                        }
+                    }
+                });
+    workers_[thread_id()].nodes += nodes;
+}
+
+} // namespace mcs
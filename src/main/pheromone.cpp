@@ -1,31 +1,312 @@
 #include "../include/pheromone.hpp"
 #include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
 
 namespace mcs {
 
-PheromoneMatrix::PheromoneMatrix(std::size_t n1, std::size_t n2, double init_value)
-    : n1_(n1), n2_(n2), pheromone_(n1 * n2, init_value) {}
+// Por debajo de esta escala se renormaliza (cada ~330 iteraciones con rho = 0.1)
+static constexpr double RENORMALIZE_BELOW = 1e-15;
+
+// Auto: la matriz densa se usa mientras no pase de este tamaño
+static constexpr std::size_t AUTO_DENSE_LIMIT_BYTES = std::size_t{256} << 20;
 
-double PheromoneMatrix::get(Vertex u, Vertex v) const {
-    return pheromone_[index(u, v)];
+static bool choose_dense(std::size_t n1, std::size_t n2,
+                         PheromoneStorage storage) {
+    if (storage == PheromoneStorage::Dense) return true;
+    if (storage == PheromoneStorage::Sparse) return false;
+    return n1 * n2 * sizeof(Tau) <= AUTO_DENSE_LIMIT_BYTES;
 }
 
+PheromoneMatrix::PheromoneMatrix(std::size_t n1, std::size_t n2,
+                                 double init_value, bool lazy,
+                                 PheromoneStorage storage)
+    : n1_(n1),
+      n2_(n2),
+      dense_(choose_dense(n1, n2, storage)),
+      pheromone_(dense_ ? n1 * n2 : 0, static_cast<Tau>(init_value)),
+      default_raw_(static_cast<Tau>(init_value)),
+      lazy_(lazy) {}
+
 void PheromoneMatrix::set(Vertex u, Vertex v, double value) {
-    pheromone_[index(u, v)] = value;
+    const Tau raw = static_cast<Tau>(value * inv_scale_);
+    if (dense_) {
+        pheromone_[index(u, v)] = raw;
+    } else {
+        sparse_slot(index(u, v)) = raw;
+    }
+}
+
+// ============================================================================
+// TABLA DISPERSA
+// ============================================================================
+static inline std::size_t hash_slot(std::uint64_t key, std::size_t mask) {
+    std::uint64_t h = key * 0x9E3779B97F4A7C15ULL;
+    h ^= h >> 32;
+    return static_cast<std::size_t>(h) & mask;
+}
+
+Tau PheromoneMatrix::sparse_get(std::uint64_t key) const {
+    if (sparse_keys_.empty()) return default_raw_;
+
+    const std::size_t mask = sparse_keys_.size() - 1;
+    for (std::size_t i = hash_slot(key, mask);; i = (i + 1) & mask) {
+        if (sparse_keys_[i] == key) return sparse_values_[i];
+        if (sparse_keys_[i] == EMPTY_KEY) return default_raw_;
+    }
+}
+
+bool PheromoneMatrix::sparse_contains(std::uint64_t key) const {
+    if (sparse_keys_.empty()) return false;
+
+    const std::size_t mask = sparse_keys_.size() - 1;
+    for (std::size_t i = hash_slot(key, mask);; i = (i + 1) & mask) {
+        if (sparse_keys_[i] == key) return true;
+        if (sparse_keys_[i] == EMPTY_KEY) return false;
+    }
+}
+
+Tau& PheromoneMatrix::sparse_slot(std::uint64_t key) {
+    // Factor de carga máximo 1/2
+    if (2 * (sparse_count_ + 1) > sparse_keys_.size()) sparse_grow();
+
+    const std::size_t mask = sparse_keys_.size() - 1;
+    std::size_t i = hash_slot(key, mask);
+    for (; sparse_keys_[i] != EMPTY_KEY; i = (i + 1) & mask) {
+        if (sparse_keys_[i] == key) return sparse_values_[i];
+    }
+
+    sparse_keys_[i] = key;
+    sparse_values_[i] = default_raw_;
+    ++sparse_count_;
+    return sparse_values_[i];
+}
+
+void PheromoneMatrix::sparse_grow() {
+    std::vector<std::uint64_t> old_keys;
+    std::vector<Tau> old_values;
+    old_keys.swap(sparse_keys_);
+    old_values.swap(sparse_values_);
+
+    const std::size_t capacity = old_keys.empty() ? 1024 : 2 * old_keys.size();
+    sparse_keys_.assign(capacity, EMPTY_KEY);
+    sparse_values_.assign(capacity, Tau{0});
+
+    const std::size_t mask = capacity - 1;
+    for (std::size_t j = 0; j < old_keys.size(); ++j) {
+        if (old_keys[j] == EMPTY_KEY) continue;
+        std::size_t i = hash_slot(old_keys[j], mask);
+        while (sparse_keys_[i] != EMPTY_KEY) i = (i + 1) & mask;
+        sparse_keys_[i] = old_keys[j];
+        sparse_values_[i] = old_values[j];
+    }
+}
+
+void PheromoneMatrix::set_bounds(double tau_min, double tau_max) {
+    tau_min_ = tau_min;
+    tau_max_ = tau_max;
+    bounded_ = tau_min > 0.0 || tau_max < std::numeric_limits<double>::infinity();
+}
+
+double PheromoneMatrix::convergence_factor() const {
+    const double range = tau_max_ - tau_min_;
+    if (!bounded_ || !(range > 0.0) || range == std::numeric_limits<double>::infinity()) {
+        return 0.0;
+    }
+
+    // Distancia al límite más lejano: range/2 en el centro, range en un extremo
+    const double lo = tau_min_, hi = tau_max_, scale = scale_;
+    double sum = 0.0;
+    if (dense_) {
+        const Tau* data = pheromone_.data();
+        const std::size_t n = pheromone_.size();
+        #pragma omp simd reduction(+:sum)
+        for (std::size_t i = 0; i < n; ++i) {
+            const double value = std::min(std::max(data[i] * scale, lo), hi);
+            sum += std::max(hi - value, value - lo);
+        }
+    } else {
+        for (std::size_t i = 0; i < sparse_keys_.size(); ++i) {
+            if (sparse_keys_[i] == EMPTY_KEY) continue;
+            const double value = clamp(sparse_values_[i] * scale);
+            sum += std::max(hi - value, value - lo);
+        }
+        const double value = clamp(default_raw_ * scale);
+        const double implicit = static_cast<double>(n1_ * n2_ - sparse_count_);
+        sum += implicit * std::max(hi - value, value - lo);
+    }
+
+    const double total = static_cast<double>(n1_) * static_cast<double>(n2_);
+    return 2.0 * (sum / (total * range) - 0.5);
 }
 
-void PheromoneMatrix::deposit(Vertex u, Vertex v, double amount) {
-    pheromone_[index(u, v)] += amount;
+double PheromoneMatrix::entropy() const {
+    const double total = static_cast<double>(n1_) * static_cast<double>(n2_);
+    if (total < 2.0) return 0.0;
+
+    // Con S = Σ τ y W = Σ τ·ln τ, H = ln S - W / S (una sola pasada)
+    double sum = 0.0, weighted = 0.0;
+    auto accumulate = [&](double value, double times) {
+        if (value <= 0.0) return;
+        sum += times * value;
+        weighted += times * value * std::log(value);
+    };
+    if (dense_) {
+        for (const Tau raw : pheromone_) accumulate(clamp(raw * scale_), 1.0);
+    } else {
+        for (std::size_t i = 0; i < sparse_keys_.size(); ++i) {
+            if (sparse_keys_[i] != EMPTY_KEY) accumulate(clamp(sparse_values_[i] * scale_), 1.0);
+        }
+        accumulate(clamp(default_raw_ * scale_),
+                   static_cast<double>(n1_ * n2_ - sparse_count_));
+    }
+    if (!(sum > 0.0)) return 0.0;
+
+    const double h = std::log(sum) - weighted / sum;
+    return std::min(1.0, std::max(0.0, h / std::log(total)));
 }
 
 void PheromoneMatrix::evaporate(double rho) {
-    for (auto& tau : pheromone_) {
-        tau *= (1.0 - rho);
+    if (!lazy_) {
+        scale_all(1.0 - rho);
+        return;
+    }
+
+    scale_ *= (1.0 - rho);
+    if (scale_ < RENORMALIZE_BELOW) {
+        renormalize();
+    } else {
+        inv_scale_ = 1.0 / scale_;
     }
 }
 
 void PheromoneMatrix::reset(double value) {
-    std::fill(pheromone_.begin(), pheromone_.end(), value);
+    std::fill(pheromone_.begin(), pheromone_.end(), static_cast<Tau>(value));
+    std::fill(sparse_keys_.begin(), sparse_keys_.end(), EMPTY_KEY);
+    sparse_count_ = 0;
+    default_raw_ = static_cast<Tau>(value);
+    scale_ = 1.0;
+    inv_scale_ = 1.0;
+}
+
+void PheromoneMatrix::blend(const PheromoneMatrix& other, double weight) {
+    const double keep = 1.0 - weight;
+
+    if (dense_ && other.dense_) {
+        // Directo sobre los valores crudos de ambas escalas
+        const double a = keep;
+        const double b = weight * other.scale_ * inv_scale_;
+        Tau* data = pheromone_.data();
+        const Tau* src = other.pheromone_.data();
+        const std::size_t n = pheromone_.size();
+        #pragma omp simd
+        for (std::size_t i = 0; i < n; ++i) {
+            data[i] = static_cast<Tau>(a * data[i] + b * src[i]);
+        }
+        return;
+    }
+
+    // Caso general por entradas: las propias (densas o guardadas) y las que
+    // solo guarda la otra matriz; el resto sale del valor por defecto
+    const double other_default = static_cast<double>(other.default_raw_) * other.scale_;
+    auto mix = [&](std::uint64_t key) {
+        const double mine = static_cast<double>(
+            dense_ ? pheromone_[key] : sparse_get(key)) * scale_;
+        const double theirs = other.dense_
+            ? static_cast<double>(other.pheromone_[key]) * other.scale_
+            : static_cast<double>(other.sparse_get(key)) * other.scale_;
+        return static_cast<Tau>((keep * mine + weight * theirs) * inv_scale_);
+    };
+
+    if (dense_) {
+        for (std::size_t key = 0; key < pheromone_.size(); ++key) {
+            pheromone_[key] = mix(key);
+        }
+        return;
+    }
+
+    for (std::size_t i = 0; i < sparse_keys_.size(); ++i) {
+        if (sparse_keys_[i] != EMPTY_KEY) sparse_values_[i] = mix(sparse_keys_[i]);
+    }
+
+    // Pares que solo la otra matriz guarda (aún con el valor por defecto aquí)
+    const Tau old_default = default_raw_;
+    const double blended_default =
+        (keep * static_cast<double>(old_default) * scale_ + weight * other_default) * inv_scale_;
+    auto add_missing = [&](std::uint64_t key, double theirs) {
+        if (sparse_contains(key)) return;
+        const double mine = static_cast<double>(old_default) * scale_;
+        sparse_slot(key) = static_cast<Tau>((keep * mine + weight * theirs) * inv_scale_);
+    };
+    if (other.dense_) {
+        for (std::size_t key = 0; key < other.pheromone_.size(); ++key) {
+            add_missing(key, static_cast<double>(other.pheromone_[key]) * other.scale_);
+        }
+    } else {
+        for (std::size_t i = 0; i < other.sparse_keys_.size(); ++i) {
+            if (other.sparse_keys_[i] == EMPTY_KEY) continue;
+            add_missing(other.sparse_keys_[i],
+                        static_cast<double>(other.sparse_values_[i]) * other.scale_);
+        }
+    }
+    default_raw_ = static_cast<Tau>(blended_default);
+}
+
+void PheromoneMatrix::renormalize() {
+    scale_all(scale_);
+    scale_ = 1.0;
+    inv_scale_ = 1.0;
+}
+
+void PheromoneMatrix::scale_all(double factor) {
+    if (dense_) {
+        scale_array(pheromone_.data(), pheromone_.size(), factor);
+    } else {
+        // Las ranuras vacías también se escalan; su valor no se usa
+        scale_array(sparse_values_.data(), sparse_values_.size(), factor);
+    }
+    default_raw_ = static_cast<Tau>(default_raw_ * factor);
+}
+
+void PheromoneMatrix::scale_array(Tau* data, std::size_t n, double factor) {
+    std::size_t i = 0;
+
+#ifdef MCS_PHEROMONE_FLOAT
+#if defined(__AVX512F__)
+    const __m512 f = _mm512_set1_ps(static_cast<float>(factor));
+    for (; i + 16 <= n; i += 16) {
+        _mm512_storeu_ps(data + i, _mm512_mul_ps(_mm512_loadu_ps(data + i), f));
+    }
+#elif defined(__AVX2__)
+    const __m256 f = _mm256_set1_ps(static_cast<float>(factor));
+    for (; i + 8 <= n; i += 8) {
+        _mm256_storeu_ps(data + i, _mm256_mul_ps(_mm256_loadu_ps(data + i), f));
+    }
+#endif
+#else
+#if defined(__AVX512F__)
+    const __m512d f = _mm512_set1_pd(factor);
+    for (; i + 8 <= n; i += 8) {
+        _mm512_storeu_pd(data + i, _mm512_mul_pd(_mm512_loadu_pd(data + i), f));
+    }
+#elif defined(__AVX2__)
+    const __m256d f = _mm256_set1_pd(factor);
+    for (; i + 4 <= n; i += 4) {
+        _mm256_storeu_pd(data + i, _mm256_mul_pd(_mm256_loadu_pd(data + i), f));
+    }
+#endif
+#endif
+
+    // Resto (o todo, sin AVX): el compilador lo vectoriza con SSE2
+    const Tau f_scalar = static_cast<Tau>(factor);
+    #pragma omp simd
+    for (std::size_t j = i; j < n; ++j) {
+        data[j] *= f_scalar;
+    }
 }
 
-} // namespace mcs
\ No newline at end of file
+} // namespace mcs
@@ -0,0 +1,131 @@
+#include "../include/power.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace mcs {
+
+// ============================================================================
+// exp / log SIN LIBM (vectorizables)
+// ============================================================================
+// Ambos usan solo aritmética, conversiones de bits y selecciones sin saltos,
+// de modo que un ciclo `omp simd` sobre ellos se traduce a instrucciones
+// vectoriales. Error relativo del orden de 1e-12 en el rango usado por el ACO.
+
+static constexpr double LN2 = 0.69314718055994530942;
+static constexpr double LN2_HI = 6.93147180369123816490e-01;
+static constexpr double LN2_LO = 1.90821492927058770002e-10;
+static constexpr double LOG2E = 1.44269504088896340736;
+static constexpr std::int32_t SQRT2_MANTISSA_HI = 0x6A09E;  // √2 ≈ 1.0x6A09E...p0
+
+// log(x) para x normal y positivo. Solo usa comparaciones enteras de 32 bits
+// (las de punto flotante impiden la vectorización con -ftrapping-math).
+static inline double fast_log(double x) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &x, sizeof bits);
+    const std::int32_t hi = static_cast<std::int32_t>(bits >> 32);
+
+    // x = m · 2^e con m en [1, 2), luego m en [√½, √2)
+    const double big = static_cast<double>((hi & 0xFFFFF) > SQRT2_MANTISSA_HI);
+    bits = (bits & 0x000fffffffffffffULL) | 0x3ff0000000000000ULL;
+    double m;
+    std::memcpy(&m, &bits, sizeof m);
+    m *= 1.0 - 0.5 * big;
+    const double e = static_cast<double>((hi >> 20) - 1023) + big;
+
+    // log(m) = 2·atanh(s), s = (m-1)/(m+1), |s| < 0.172
+    const double s = (m - 1.0) / (m + 1.0);
+    const double s2 = s * s;
+    const double p =
+        1.0 + s2 * (1.0 / 3 + s2 * (1.0 / 5 + s2 * (1.0 / 7 + s2 * (1.0 / 9 +
+        s2 * (1.0 / 11 + s2 * (1.0 / 13))))));
+    return e * LN2 + 2.0 * s * p;
+}
+
+// exp(y); fuera de [-708, 709] el resultado se satura
+static inline double fast_exp(double y) {
+    // k = round(y / ln2) con el truco del número mágico 1.5 · 2^52
+    const double MAGIC = 6755399441055744.0;
+    const double kd = y * LOG2E + MAGIC;
+    std::int64_t ki;
+    std::memcpy(&ki, &kd, sizeof ki);
+    const double kf = kd - MAGIC;
+    const std::int32_t k =
+        std::min(std::max(static_cast<std::int32_t>(ki), -1022), 1023);
+
+    // exp(r) con |r| <= ln2/2 por Taylor de grado 11
+    const double r = (y - kf * LN2_HI) - kf * LN2_LO;
+    const double p =
+        1.0 + r * (1.0 + r * (1.0 / 2 + r * (1.0 / 6 + r * (1.0 / 24 +
+        r * (1.0 / 120 + r * (1.0 / 720 + r * (1.0 / 5040 +
+        r * (1.0 / 40320 + r * (1.0 / 362880 + r * (1.0 / 3628800 +
+        r * (1.0 / 39916800)))))))))));
+
+    const std::uint64_t scale_bits = static_cast<std::uint64_t>(k + 1023) << 52;
+    double scale;
+    std::memcpy(&scale, &scale_bits, sizeof scale);
+    return p * scale;
+}
+
+// ============================================================================
+// PowerKernel
+// ============================================================================
+PowerKernel::PowerKernel(double exponent)
+    : exponent_(exponent), kind_(Kind::General), n_(0) {
+    if (exponent >= 0.0 && exponent <= 8.0 && std::floor(exponent) == exponent) {
+        n_ = static_cast<unsigned>(exponent);
+        switch (n_) {
+            case 0: kind_ = Kind::Zero; break;
+            case 1: kind_ = Kind::One; break;
+            case 2: kind_ = Kind::Square; break;
+            case 3: kind_ = Kind::Cube; break;
+            default: kind_ = Kind::Integer; break;
+        }
+    }
+}
+
+void PowerKernel::apply(double* x, std::size_t count) const {
+    switch (kind_) {
+        case Kind::Zero:
+            for (std::size_t i = 0; i < count; ++i) x[i] = 1.0;
+            break;
+
+        case Kind::One:
+            break;
+
+        case Kind::Square:
+            #pragma omp simd
+            for (std::size_t i = 0; i < count; ++i) x[i] = x[i] * x[i];
+            break;
+
+        case Kind::Cube:
+            #pragma omp simd
+            for (std::size_t i = 0; i < count; ++i) x[i] = x[i] * x[i] * x[i];
+            break;
+
+        case Kind::Integer:
+            // Exponenciación binaria; n_ <= 8 son a lo más 4 cuadrados
+            for (std::size_t i = 0; i < count; ++i) {
+                double base = x[i];
+                double result = 1.0;
+                for (unsigned n = n_; n; n >>= 1) {
+                    if (n & 1u) result *= base;
+                    base *= base;
+                }
+                x[i] = result;
+            }
+            break;
+
+        case Kind::General: {
+            const double e = exponent_;
+            #pragma omp simd
+            for (std::size_t i = 0; i < count; ++i) {
+                x[i] = fast_exp(e * fast_log(x[i]));
+            }
+            break;
+        }
+    }
+}
+
+} // namespace mcs
@@ -0,0 +1,189 @@
+#include "../include/profile.hpp"
+#include <array>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace mcs {
+namespace profile {
+
+namespace {
+
+constexpr std::size_t NUM_COUNTERS = static_cast<std::size_t>(Counter::Count);
+constexpr std::size_t NUM_PHASES = static_cast<std::size_t>(Phase::Count);
+
+constexpr std::array<const char*, NUM_COUNTERS> COUNTER_KEYS = {
+    "sample_attempts", "sample_accepted", "feasibility_checks",
+    "heuristic_evals", "pair_selections", "solutions"};
+
+constexpr std::array<const char*, NUM_COUNTERS> COUNTER_LABELS = {
+    "Intentos de muestreo", "Candidatos aceptados", "Pruebas de factibilidad",
+    "Evaluaciones heurística", "Selecciones de par", "Soluciones construidas"};
+
+constexpr std::array<const char*, NUM_PHASES> PHASE_KEYS = {
+    "read", "construction", "sampling", "selection",
+    "local_search", "pheromone_update", "export", "svg"};
+
+constexpr std::array<const char*, NUM_PHASES> PHASE_LABELS = {
+    "Lectura", "Construcción", "  muestreo", "  selección",
+    "Búsqueda local", "Feromonas", "Exportación", "SVG"};
+
+/// Acumuladores de un hilo; alineados para no compartir línea de caché.
+struct alignas(64) Slot {
+    std::array<std::uint64_t, NUM_COUNTERS> counters{};
+    std::array<double, NUM_PHASES> phases{};
+    double busy = 0.0;
+    double team = 0.0;
+};
+
+// std::deque no mueve los elementos al crecer, así que los punteros
+// thread_local siguen siendo válidos mientras se registran hilos nuevos.
+// OpenMP anidado (islas) crea y destruye hilos; al terminar, un hilo deja su
+// ranura libre para el siguiente, y hay tantas ranuras como hilos simultáneos.
+std::mutex registry_mutex;
+std::deque<Slot> registry;
+std::vector<Slot*> free_slots;
+
+class SlotLease {
+public:
+    SlotLease() {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        if (free_slots.empty()) {
+            slot_ = &registry.emplace_back();
+        } else {
+            slot_ = free_slots.back();
+            free_slots.pop_back();
+        }
+    }
+    ~SlotLease() {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        free_slots.push_back(slot_);
+    }
+
+    Slot& slot() { return *slot_; }
+
+private:
+    Slot* slot_;
+};
+
+Slot& local_slot() {
+    thread_local SlotLease lease;
+    return lease.slot();
+}
+
+struct Totals {
+    std::array<std::uint64_t, NUM_COUNTERS> counters{};
+    std::array<double, NUM_PHASES> phases{};
+    std::vector<const Slot*> threads;  // solo los que construyeron hormigas
+};
+
+Totals collect() {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    Totals t;
+    for (const Slot& s : registry) {
+        for (std::size_t i = 0; i < NUM_COUNTERS; ++i) t.counters[i] += s.counters[i];
+        for (std::size_t i = 0; i < NUM_PHASES; ++i) t.phases[i] += s.phases[i];
+        if (s.team > 0.0) t.threads.push_back(&s);
+    }
+    return t;
+}
+
+std::uint64_t counter(const Totals& t, Counter c) {
+    return t.counters[static_cast<std::size_t>(c)];
+}
+
+double ratio(std::uint64_t num, std::uint64_t den) {
+    return den > 0 ? static_cast<double>(num) / static_cast<double>(den) : 0.0;
+}
+
+} // namespace
+
+void add(Counter c, std::uint64_t amount) {
+    local_slot().counters[static_cast<std::size_t>(c)] += amount;
+}
+
+void add_time(Phase phase, double seconds) {
+    local_slot().phases[static_cast<std::size_t>(phase)] += seconds;
+}
+
+void add_busy(double seconds) { local_slot().busy += seconds; }
+
+void add_team(double seconds) { local_slot().team += seconds; }
+
+void print_report(std::ostream& out) {
+    if (!enabled()) {
+        out << "Perfil no disponible: recompilar con meson configure -Dprofile=true\n";
+        return;
+    }
+
+    const Totals t = collect();
+    const auto flags = out.flags();
+    const auto precision = out.precision();
+    out << std::fixed;
+
+    out << "\n=== Perfil ===\n";
+    out << "Tiempo por fase (s, sumado entre hilos):\n";
+    for (std::size_t i = 0; i < NUM_PHASES; ++i) {
+        out << "  " << std::left << std::setw(18) << PHASE_LABELS[i] << std::right
+            << std::setprecision(4) << std::setw(12) << t.phases[i] << '\n';
+    }
+
+    out << "Contadores:\n";
+    for (std::size_t i = 0; i < NUM_COUNTERS; ++i) {
+        out << "  " << std::left << std::setw(26) << COUNTER_LABELS[i] << std::right
+            << std::setw(16) << t.counters[i] << '\n';
+    }
+    out << "  Tasa de aceptación del muestreo: " << std::setprecision(3)
+        << 100.0 * ratio(counter(t, Counter::SampleAccepted),
+                         counter(t, Counter::SampleAttempts))
+        << "%\n";
+
+    if (!t.threads.empty()) {
+        out << "Hilos (s):      ocupado       ocioso\n";
+        for (std::size_t i = 0; i < t.threads.size(); ++i) {
+            const Slot& s = *t.threads[i];
+            out << "  #" << std::left << std::setw(6) << i << std::right
+                << std::setprecision(4) << std::setw(13) << s.busy
+                << std::setw(13) << (s.team - s.busy) << '\n';
+        }
+    }
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+void write_json(const std::string& path) {
+    std::ofstream out(path);
+    if (!out) throw std::runtime_error("No se pudo escribir el perfil: " + path);
+
+    out << std::setprecision(9);
+    out << "{\n  \"enabled\": " << (enabled() ? "true" : "false");
+    if (enabled()) {
+        const Totals t = collect();
+        out << ",\n  \"phases_seconds\": {";
+        for (std::size_t i = 0; i < NUM_PHASES; ++i) {
+            out << (i ? ", " : "") << '"' << PHASE_KEYS[i] << "\": " << t.phases[i];
+        }
+        out << "},\n  \"counters\": {";
+        for (std::size_t i = 0; i < NUM_COUNTERS; ++i) {
+            out << (i ? ", " : "") << '"' << COUNTER_KEYS[i] << "\": " << t.counters[i];
+        }
+        out << "},\n  \"sample_acceptance\": "
+            << ratio(counter(t, Counter::SampleAccepted), counter(t, Counter::SampleAttempts));
+        out << ",\n  \"threads\": [";
+        for (std::size_t i = 0; i < t.threads.size(); ++i) {
+            const Slot& s = *t.threads[i];
+            out << (i ? ", " : "") << "{\"busy\": " << s.busy
+                << ", \"idle\": " << (s.team - s.busy) << '}';
+        }
+        out << ']';
+    }
+    out << "\n}\n";
+    if (!out) throw std::runtime_error("No se pudo escribir el perfil: " + path);
+}
+
+} // namespace profile
+} // namespace mcs
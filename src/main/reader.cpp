@@ -1,73 +1,222 @@
 #include "../include/reader.hpp"
 #include "../include/graph.hpp"
+#include "../include/graph_cache.hpp"
+#include "../include/mapped_file.hpp"
+#include "../include/profile.hpp"
+#include <algorithm>
+#include <cstring>
+#include <functional>
 #include <iostream>
 #include <stdexcept>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace mcs {
 
-Graph Reader::read_graph(const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file) {
-        throw std::runtime_error("No se puede abrir: " + filename);
-    }
+using Vertex = Graph::Vertex;
 
-    name_to_id_.clear();
-    id_to_name_.clear();
+// Tamaño mínimo de un bloque para repartir la lectura entre hilos
+static constexpr std::size_t PARALLEL_CHUNK_BYTES = std::size_t{4} << 20;
 
-    std::vector<std::pair<std::string, std::string>> edges;
-    std::string line;
+namespace {
 
-    while (std::getline(file, line)) {
-        if (line.empty() || line[0] == '#') continue;
+/**
+ * Tabla de nombres con direccionamiento abierto. Las claves son vistas al
+ * texto de entrada (que hace de arena: no se copia ningún nombre) y cada
+ * casilla guarda solo el id; el hash de cada nombre se conserva para crecer
+ * y para fusionar tablas sin volver a calcularlo.
+ */
+class NameTable {
+public:
+    NameTable() : slots_(1024, -1), mask_(1023) {}
 
-        std::string u, v;
-        if (parse_edge_line(line, u, v)) {
-            edges.emplace_back(u, v);
+    Vertex intern(std::string_view name, std::size_t hash) {
+        std::size_t slot = hash & mask_;
+        while (slots_[slot] >= 0) {
+            const Vertex id = slots_[slot];
+            if (hashes_[id] == hash && names_[id] == name) return id;
+            slot = (slot + 1) & mask_;
         }
+
+        const Vertex id = static_cast<Vertex>(names_.size());
+        slots_[slot] = id;
+        names_.push_back(name);
+        hashes_.push_back(hash);
+        if (names_.size() * 2 > slots_.size()) grow();
+        return id;
     }
 
-    // Crear grafoca
-    Graph g(id_to_name_.size());
-    for (const auto& [u_name, v_name] : edges) {
-        int u = name_to_id_[u_name];
-        int v = name_to_id_[v_name];
-        g.add_edge(u, v);
+    std::size_t size() const { return names_.size(); }
+    std::string_view name(Vertex id) const { return names_[id]; }
+    std::size_t hash(Vertex id) const { return hashes_[id]; }
+
+private:
+    std::vector<Vertex> slots_;  // -1 = libre
+    std::vector<std::string_view> names_;
+    std::vector<std::size_t> hashes_;
+    std::size_t mask_;
+
+    void grow() {
+        slots_.assign(slots_.size() * 2, -1);
+        mask_ = slots_.size() - 1;
+        for (Vertex id = 0; id < static_cast<Vertex>(names_.size()); ++id) {
+            std::size_t slot = hashes_[id] & mask_;
+            while (slots_[slot] >= 0) slot = (slot + 1) & mask_;
+            slots_[slot] = id;
+        }
     }
+};
 
-    return g;
+/// Nombres y aristas de un bloque de líneas, con ids locales al bloque.
+struct Chunk {
+    NameTable names;
+    std::vector<std::pair<Vertex, Vertex>> edges;
+};
+
+// Los mismos separadores que operator>> en la configuración regional "C"
+inline bool is_space(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+void parse_chunk(const char* p, const char* end, Chunk& out) {
+    const std::hash<std::string_view> hasher;
+
+    while (p < end) {
+        const char* eol = static_cast<const char*>(std::memchr(p, '\n', end - p));
+        if (!eol) eol = end;
+
+        if (p != eol && *p != '#') {
+            std::string_view tokens[2];
+            int count = 0;
+            const char* q = p;
+            while (count < 2) {
+                while (q < eol && is_space(*q)) ++q;
+                if (q == eol) break;
+                const char* start = q;
+                while (q < eol && !is_space(*q)) ++q;
+                tokens[count++] = std::string_view(start, q - start);
+            }
+
+            if (count == 2) {
+                // Quitar ';' si existe
+                if (!tokens[1].empty() && tokens[1].back() == ';') {
+                    tokens[1].remove_suffix(1);
+                }
+                const Vertex u = out.names.intern(tokens[0], hasher(tokens[0]));
+                const Vertex v = out.names.intern(tokens[1], hasher(tokens[1]));
+                out.edges.emplace_back(u, v);
+            }
+        }
+
+        if (eol == end) break;
+        p = eol + 1;
+    }
+}
+
+int reader_threads() {
+#ifdef _OPENMP
+    // Dentro de otra región paralela (p. ej. el modo por lotes) no se anida
+    return omp_in_parallel() ? 1 : omp_get_max_threads();
+#else
+    return 1;
+#endif
 }
 
-int Reader::get_or_create_id(const std::string& name) {
-    auto it = name_to_id_.find(name);
-    if (it != name_to_id_.end()) {
-        return it->second;
+} // namespace
+
+static bool ends_with(const std::string& s, const std::string& suffix) {
+    return s.size() >= suffix.size() &&
+           s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+Graph Reader::read_graph(const std::string& filename, GraphStorage storage) {
+    MCS_PROFILE_PHASE(Read);
+    Graph g(0);
+    from_cache_ = true;
+
+    // Caché pasado directamente: no hay texto contra el cual validarlo
+    if (ends_with(filename, GRAPH_CACHE_EXTENSION)) {
+        if (!load_graph_cache(filename, "", storage, g, id_to_name_)) {
+            throw std::runtime_error("Caché inválido o con otro almacenamiento: " + filename);
+        }
+        return g;
     }
 
-    int id = static_cast<int>(id_to_name_.size());
-    name_to_id_[name] = id;
-    id_to_name_.push_back(name);
-    return id;
+    const std::string cache = filename + GRAPH_CACHE_EXTENSION;
+    if (load_graph_cache(cache, filename, storage, g, id_to_name_)) return g;
+
+    from_cache_ = false;
+    {
+        const MappedFile file(filename);
+        g = parse_graph(file.view(), storage);
+    }
+
+    if (write_cache_) {
+        try {
+            write_graph_cache(cache, g, id_to_name_, filename);
+        } catch (const std::exception& e) {
+            // Sin caché la lectura sigue siendo válida
+            std::cerr << "Aviso: no se pudo escribir " << cache << ": " << e.what() << "\n";
+        }
+    }
+    return g;
 }
 
-bool Reader::parse_edge_line(const std::string& line,
-                             std::string& u,
-                             std::string& v) const {
-    std::istringstream iss(line);
-    std::string token;
+Graph Reader::parse_graph(std::string_view text, GraphStorage storage) {
+    const char* begin = text.data();
+    const char* end = begin + text.size();
 
-    if (!(iss >> u >> v)) {
-        return false;
+    // Bloques que terminan en fin de línea
+    const std::size_t by_size = text.size() / PARALLEL_CHUNK_BYTES;
+    const std::size_t num_chunks = std::max<std::size_t>(
+        1, std::min<std::size_t>(by_size, static_cast<std::size_t>(reader_threads())));
+    std::vector<const char*> bounds{begin};
+    for (std::size_t k = 1; k < num_chunks; ++k) {
+        const char* cut = std::max(bounds.back(), begin + text.size() / num_chunks * k);
+        const void* nl = cut < end ? std::memchr(cut, '\n', end - cut) : nullptr;
+        bounds.push_back(nl ? static_cast<const char*>(nl) + 1 : end);
     }
+    bounds.push_back(end);
 
-    // Quitar ';' si existe
-    if (!v.empty() && v.back() == ';') {
-        v.pop_back();
+    std::vector<Chunk> chunks(num_chunks);
+    #pragma omp parallel for schedule(static, 1) if (num_chunks > 1)
+    for (std::size_t k = 0; k < num_chunks; ++k) {
+        parse_chunk(bounds[k], bounds[k + 1], chunks[k]);
     }
 
-    // Crear IDs si no existen
-    const_cast<Reader*>(this)->get_or_create_id(u);
-    const_cast<Reader*>(this)->get_or_create_id(v);
+    // Ids globales: recorrer los bloques en orden conserva el orden de
+    // primera aparición de la lectura secuencial
+    NameTable names;
+    std::vector<std::vector<Vertex>> remap(num_chunks);
+    std::vector<std::size_t> first_edge(num_chunks + 1, 0);
+    for (std::size_t k = 0; k < num_chunks; ++k) {
+        const NameTable& local = chunks[k].names;
+        remap[k].resize(local.size());
+        for (Vertex id = 0; id < static_cast<Vertex>(local.size()); ++id) {
+            remap[k][id] = names.intern(local.name(id), local.hash(id));
+        }
+        first_edge[k + 1] = first_edge[k] + chunks[k].edges.size();
+    }
+
+    std::vector<std::pair<Vertex, Vertex>> edges(first_edge[num_chunks]);
+    #pragma omp parallel for schedule(static, 1) if (num_chunks > 1)
+    for (std::size_t k = 0; k < num_chunks; ++k) {
+        const std::vector<Vertex>& ids = remap[k];
+        std::size_t out = first_edge[k];
+        for (const auto& [u, v] : chunks[k].edges) edges[out++] = {ids[u], ids[v]};
+    }
+    chunks.clear();
 
-    return true;
+    id_to_name_.clear();
+    id_to_name_.reserve(names.size());
+    for (Vertex id = 0; id < static_cast<Vertex>(names.size()); ++id) {
+        id_to_name_.emplace_back(names.name(id));
+    }
+
+    // Crear gráfica
+    return Graph(id_to_name_.size(), edges, storage);
 }
-} // namespace mcs
\ No newline at end of file
+
+} // namespace mcs
@@ -0,0 +1,100 @@
+#include "../include/telemetry.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <stdexcept>
+
+namespace mcs {
+
+TelemetryWriter::TelemetryWriter(const std::string& path, TelemetryFormat format,
+                                 std::size_t capacity)
+    : out_(path), format_(format), ring_(std::max<std::size_t>(capacity, 1)) {
+    if (!out_.is_open()) {
+        throw std::runtime_error("No se pudo crear el archivo de telemetría: " + path);
+    }
+    if (format_ == TelemetryFormat::Csv) {
+        out_ << "isla,iteracion,mejor,aristas,media,maximo,entropia,segundos\n";
+    }
+    worker_ = std::thread([this] { run(); });
+}
+
+TelemetryWriter::~TelemetryWriter() { close(); }
+
+TelemetryFormat TelemetryWriter::format_for(const std::string& path) {
+    const std::string ext = ".csv";
+    const bool csv = path.size() >= ext.size() &&
+                     path.compare(path.size() - ext.size(), ext.size(), ext) == 0;
+    return csv ? TelemetryFormat::Csv : TelemetryFormat::Ndjson;
+}
+
+void TelemetryWriter::push(const IterationStats& stats) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (count_ == ring_.size()) {
+            ++dropped_;
+            return;
+        }
+        ring_[(head_ + count_) % ring_.size()] = stats;
+        ++count_;
+    }
+    ready_.notify_one();
+}
+
+bool TelemetryWriter::close() {
+    if (closed_) return ok_;
+    closed_ = true;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    ready_.notify_one();
+    worker_.join();
+    ok_ = out_.close();
+    return ok_;
+}
+
+std::uint64_t TelemetryWriter::dropped() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return dropped_;
+}
+
+void TelemetryWriter::run() {
+    std::vector<IterationStats> batch;
+    batch.reserve(ring_.size());
+
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            ready_.wait(lock, [this] { return count_ > 0 || stop_; });
+            if (count_ == 0) return;  // stop_ y nada pendiente
+
+            batch.clear();
+            for (std::size_t i = 0; i < count_; ++i) {
+                batch.push_back(ring_[(head_ + i) % ring_.size()]);
+            }
+            head_ = (head_ + count_) % ring_.size();
+            count_ = 0;
+        }
+
+        // E/S fuera del candado: los productores no esperan al disco
+        // Lote completo en disco: quien sigue el archivo lo ve sin esperar al cierre
+        for (const IterationStats& s : batch) write(s);
+        out_.sync();
+    }
+}
+
+void TelemetryWriter::write(const IterationStats& s) {
+    char line[256];
+    const char* pattern =
+        format_ == TelemetryFormat::Csv
+            ? "%d,%d,%d,%d,%.4f,%d,%.6f,%.6f\n"
+            : "{\"isla\":%d,\"iteracion\":%d,\"mejor\":%d,\"aristas\":%d,"
+              "\"media\":%.4f,\"maximo\":%d,\"entropia\":%.6f,\"segundos\":%.6f}\n";
+    const int len = std::snprintf(line, sizeof(line), pattern, s.colony, s.iteration,
+                                  s.best_size, s.best_edges, s.mean_score,
+                                  s.max_score, s.entropy, s.seconds);
+    if (len > 0) {
+        out_ << std::string_view(line, std::min<std::size_t>(len, sizeof(line) - 1));
+    }
+}
+
+} // namespace mcs
@@ -0,0 +1,113 @@
+#include "../include/batch.hpp"
+#include "../include/mcs.hpp"
+#include "../include/reader.hpp"
+#include "test_common.hpp"
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace mcs;
+
+/**
+ * @brief Exacto e híbrido con varios hilos por fuera (modo por lotes y
+ * llamadas a mcs::solve desde una región paralela ajena).
+ *
+ * Cada par corre con num_threads = 1 dentro de un hilo cualquiera del
+ * llamador; el resultado debe coincidir con el de una corrida secuencial.
+ * Se compila con _GLIBCXX_ASSERTIONS para detectar accesos fuera de rango.
+ */
+
+static constexpr int OUTER_THREADS = 4;
+static constexpr std::size_t NUM_GRAPHS = 5;
+static constexpr std::size_t N = 18;
+
+static SolveOptions options_for(Solver solver) {
+    SolveOptions options;
+    options.solver = solver;
+    options.aco.seed = 5;
+    options.aco.num_ants = 4;
+    options.aco.max_iterations = 5;
+    options.aco.num_threads = 1;
+    return options;
+}
+
+int main() {
+#ifdef _OPENMP
+    omp_set_num_threads(OUTER_THREADS);
+#endif
+    namespace fs = std::filesystem;
+    const fs::path dir = fs::temp_directory_path() / "mcs_test_batch_threads";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+
+    Rng rng(17);
+    std::vector<std::string> files;
+    std::vector<Graph> graphs;
+    for (std::size_t i = 0; i < NUM_GRAPHS; ++i) {
+        const test::EdgeList edges = test::erdos_renyi(N, 0.3, rng);
+        const std::string path = (dir / ("g" + std::to_string(i) + ".txt")).string();
+        {
+            std::ofstream out(path);
+            for (const auto& [u, v] : edges) out << u << ' ' << v << '\n';
+        }
+        files.push_back(path);
+        // Se leen igual que en el modo por lotes para comparar las mismas gráficas
+        graphs.push_back(Reader().read_graph(path));
+    }
+
+    for (Solver solver : {Solver::Exact, Solver::Hybrid}) {
+        // Referencia secuencial: tamaño del MCIS de cada par i < j
+        std::map<std::pair<std::size_t, std::size_t>, int> expected;
+        for (std::size_t i = 0; i < NUM_GRAPHS; ++i) {
+            for (std::size_t j = i + 1; j < NUM_GRAPHS; ++j) {
+                expected[{i, j}] = solve(graphs[i], graphs[j], options_for(solver)).size;
+            }
+        }
+
+        // mcs::solve dentro de una región paralela del llamador
+        std::vector<int> sizes(NUM_GRAPHS * NUM_GRAPHS, -1);
+        #pragma omp parallel for schedule(dynamic, 1) num_threads(OUTER_THREADS)
+        for (std::size_t k = 0; k < NUM_GRAPHS * NUM_GRAPHS; ++k) {
+            const std::size_t i = k / NUM_GRAPHS, j = k % NUM_GRAPHS;
+            if (i < j) sizes[k] = solve(graphs[i], graphs[j], options_for(solver)).size;
+        }
+        for (const auto& [pair, size] : expected) {
+            CHECK(sizes[pair.first * NUM_GRAPHS + pair.second] == size);
+        }
+
+        // Modo por lotes (--all-pairs)
+        BatchParams batch;
+        batch.solver = solver;
+        batch.csv_path = (dir / "pares.csv").string();
+        ACOParams params = options_for(solver).aco;
+        BatchRunner(params, batch).run_all_pairs(files);
+
+        std::ifstream csv(batch.csv_path);
+        std::string line;
+        std::getline(csv, line);  // encabezado
+        std::size_t rows = 0;
+        while (std::getline(csv, line)) {
+            std::istringstream fields(line);
+            std::string field;
+            std::vector<std::string> cols;
+            while (std::getline(fields, field, ',')) cols.push_back(field);
+            CHECK(cols.size() == 10);
+            const std::size_t i = std::stoul(cols[0]), j = std::stoul(cols[1]);
+            CHECK(std::stoi(cols[6]) == expected.at({i, j}));
+            ++rows;
+        }
+        CHECK(rows == expected.size());
+    }
+
+    fs::remove_all(dir);
+    std::cout << "batch_threads: ok\n";
+    return 0;
+}
@@ -0,0 +1,188 @@
+#include "../include/graph_cache.hpp"
+#include "test_common.hpp"
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace mcs;
+
+/**
+ * @brief Un caché .mcsg dañado se rechaza (false) en lugar de leerse fuera
+ * del mapeo o de reservar memoria según un encabezado corrupto.
+ *
+ * Cada caso parte de un caché válido y modifica un campo; las posiciones
+ * siguen el formato documentado en graph_cache.hpp.
+ */
+
+namespace fs = std::filesystem;
+using Bytes = std::vector<char>;
+
+static constexpr std::size_t N = 40;
+static constexpr std::size_t HEADER = 64;
+
+static std::size_t align64(std::size_t x) { return (x + 63) / 64 * 64; }
+
+static Bytes read_all(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return Bytes(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+static bool loads(const std::string& path, const Bytes& bytes) {
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+    Graph g(0);
+    std::vector<std::string> names;
+    return load_graph_cache(path, "", GraphStorage::Auto, g, names);
+}
+
+template <class T>
+static T get(const Bytes& bytes, std::size_t pos) {
+    T value;
+    std::memcpy(&value, bytes.data() + pos, sizeof value);
+    return value;
+}
+
+template <class T>
+static Bytes with(Bytes bytes, std::size_t pos, T value) {
+    std::memcpy(bytes.data() + pos, &value, sizeof value);
+    return bytes;
+}
+
+static void check_cache(const fs::path& dir, GraphStorage storage) {
+    Rng rng(23);
+    const Graph g(N, test::erdos_renyi(N, 0.15, rng), storage);
+    std::vector<std::string> names;
+    for (std::size_t i = 0; i < N; ++i) names.push_back("v" + std::to_string(i));
+
+    const std::string path = (dir / "g.mcsg").string();
+    write_graph_cache(path, g, names, "");
+    const Bytes good = read_all(path);
+    const std::string bad = (dir / "dañado.mcsg").string();
+
+    // El caché intacto se carga con las mismas aristas y nombres
+    {
+        Graph loaded(0);
+        std::vector<std::string> loaded_names;
+        CHECK(load_graph_cache(path, "", storage, loaded, loaded_names));
+        CHECK(loaded_names == names);
+        for (Graph::Vertex u = 0; u < static_cast<Graph::Vertex>(N); ++u) {
+            CHECK(loaded.degree(u) == g.degree(u));
+            for (Graph::Vertex v = 0; v < static_cast<Graph::Vertex>(N); ++v) {
+                CHECK(loaded.edge(u, v) == g.edge(u, v));
+            }
+        }
+    }
+
+    const bool dense = g.is_dense();
+    const auto entries = get<std::uint64_t>(good, 32);
+    const std::size_t adj = align64(HEADER + N * sizeof(int));
+    const std::size_t targets = align64(adj + (N + 1) * sizeof(std::uint64_t));
+    const std::size_t end = dense ? adj + N * g.words_per_row() * sizeof(Word)
+                                  : targets + entries * sizeof(Graph::Vertex);
+    const std::size_t name_offsets = align64(end);
+    auto name_offset = [&](std::size_t i) { return name_offsets + i * sizeof(std::uint64_t); };
+
+    // Archivo truncado y tamaños del encabezado que desbordan
+    CHECK(!loads(bad, Bytes(good.begin(), good.end() - 1)));
+    CHECK(!loads(bad, with<std::uint64_t>(good, 16, std::uint64_t{1} << 40)));
+    CHECK(!loads(bad, with<std::uint64_t>(good, 40, ~std::uint64_t{0} - 8)));
+    if (!dense) {
+        CHECK(!loads(bad, with<std::uint64_t>(good, 32, std::uint64_t{1} << 62)));
+    }
+
+    // Grado que no coincide con su fila
+    CHECK(!loads(bad, with<int>(good, HEADER, -5)));
+    CHECK(!loads(bad, with<int>(good, HEADER, g.degree(0) + 1)));
+
+    // Inicio de nombre decreciente o más allá de la sección de nombres
+    const auto second = get<std::uint64_t>(good, name_offset(2));
+    CHECK(!loads(bad, with<std::uint64_t>(good, name_offset(1), second + 1)));
+    CHECK(!loads(bad, with<std::uint64_t>(good, name_offset(1), ~std::uint64_t{0})));
+    CHECK(!loads(bad, with<std::uint64_t>(good, name_offset(0), 1)));
+
+    if (!dense) {
+        // Offsets CSR decrecientes y vecinos fuera de [0, n)
+        const std::size_t offsets = adj;
+        const auto row2 = get<std::uint64_t>(good, offsets + 2 * sizeof(std::uint64_t));
+        CHECK(!loads(bad, with<std::uint64_t>(good, offsets + sizeof(std::uint64_t), row2 + 1)));
+        CHECK(!loads(bad, with<std::uint64_t>(good, offsets + sizeof(std::uint64_t),
+                                              ~std::uint64_t{0})));
+        CHECK(entries > 0);
+        CHECK(!loads(bad, with<Graph::Vertex>(good, targets, static_cast<Graph::Vertex>(N))));
+        CHECK(!loads(bad, with<Graph::Vertex>(good, targets, -1)));
+        if (g.degree(0) >= 2) {
+            // Fila desordenada (edge() hace búsqueda binaria)
+            const auto first = get<Graph::Vertex>(good, targets);
+            const auto second = get<Graph::Vertex>(good, targets + sizeof(Graph::Vertex));
+            CHECK(!loads(bad, with<Graph::Vertex>(with<Graph::Vertex>(good, targets, second),
+                                                  targets + sizeof(Graph::Vertex), first)));
+        }
+    } else {
+        // Bit más allá de n en la última palabra de una fila
+        const std::size_t last_word = adj + (g.words_per_row() - 1) * sizeof(Word);
+        const Word padding = Word{1} << (N % WORD_BITS);
+        CHECK(!loads(bad, with<Word>(good, last_word, get<Word>(good, last_word) | padding)));
+    }
+
+    // Sin cambios vuelve a cargarse
+    CHECK(loads(bad, good));
+}
+
+// Un vértice con lazo vecino de todos tiene grado n + 1: el caché es válido
+static void check_full_loop(const fs::path& dir, GraphStorage storage) {
+    test::EdgeList edges = {{0, 0}};
+    for (Graph::Vertex v = 1; v < static_cast<Graph::Vertex>(N); ++v) edges.emplace_back(0, v);
+    const Graph g(N, edges, storage);
+    CHECK(g.degree(0) == static_cast<int>(N) + 1);
+
+    std::vector<std::string> names;
+    for (std::size_t i = 0; i < N; ++i) names.push_back(std::to_string(i));
+    const std::string path = (dir / "lazo.mcsg").string();
+    write_graph_cache(path, g, names, "");
+
+    Graph loaded(0);
+    std::vector<std::string> loaded_names;
+    CHECK(load_graph_cache(path, "", storage, loaded, loaded_names));
+    CHECK(loaded.degree(0) == g.degree(0));
+}
+
+// Los temporales no quedan en el directorio, ni al terminar ni si falla el renombrado
+static void check_temporaries(const fs::path& dir) {
+    const Graph g(N, {{0, 1}});
+    const std::vector<std::string> names(N, "v");
+    const fs::path blocked = dir / "ocupado.mcsg";
+    fs::create_directories(blocked / "dentro");  // renombrar sobre un directorio no vacío falla
+
+    bool threw = false;
+    try {
+        write_graph_cache(blocked.string(), g, names, "");
+    } catch (const std::exception&) {
+        threw = true;
+    }
+    CHECK(threw);
+    for (const auto& entry : fs::directory_iterator(dir)) {
+        CHECK(entry.path().extension() != ".tmp");
+    }
+}
+
+int main() {
+    const fs::path dir = fs::temp_directory_path() / "mcs_test_graph_cache";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+
+    check_cache(dir, GraphStorage::Dense);
+    check_cache(dir, GraphStorage::Sparse);
+    check_full_loop(dir, GraphStorage::Dense);
+    check_full_loop(dir, GraphStorage::Sparse);
+    check_temporaries(dir);
+
+    fs::remove_all(dir);
+    std::cout << "graph_cache: ok\n";
+    return 0;
+}
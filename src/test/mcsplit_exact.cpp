@@ -0,0 +1,82 @@
+#include "../include/mcsplit.hpp"
+#include "test_common.hpp"
+#include <algorithm>
+
+using namespace mcs;
+
+/**
+ * @brief McSplit contra búsqueda exhaustiva en gráficas pequeñas con lazos.
+ *
+ * La fuerza bruta usa Mapping::is_feasible_add, la misma condición que el
+ * ACO y scripts/check.py (los lazos no cuentan), así que el exacto debe
+ * reportar el mismo óptimo y un mapeo que esa condición acepte.
+ */
+
+static constexpr int RANDOM_PAIRS = 300;
+static constexpr std::size_t MAX_N = 7;
+
+// Máximo mapeo factible extendiendo `mapping` con los vértices u..n1-1 de g1
+static int brute_force(const Graph& g1, const Graph& g2, Mapping& mapping,
+                       Vertex u, int best) {
+    const int n1 = static_cast<int>(g1.num_vertices());
+    if (u == n1) return std::max(best, mapping.size());
+    if (mapping.size() + (n1 - u) <= best) return best;
+
+    for (Vertex v = 0; v < static_cast<Vertex>(g2.num_vertices()); ++v) {
+        if (mapping.is_mapped_g2(v) || !mapping.is_feasible_add(u, v, g1, g2)) continue;
+        mapping.add_pair(u, v);
+        best = brute_force(g1, g2, mapping, u + 1, best);
+        mapping.remove_pair(u);
+    }
+    return brute_force(g1, g2, mapping, u + 1, best);
+}
+
+// El mapeo se puede reconstruir par a par con la condición de factibilidad
+static bool feasible(const Graph& g1, const Graph& g2, const Mapping& mapping) {
+    Mapping check(g1.num_vertices(), g2.num_vertices());
+    for (const auto& [u, v] : mapping.pairs()) {
+        if (!check.is_feasible_add(u, v, g1, g2)) return false;
+        check.add_pair(u, v);
+    }
+    return true;
+}
+
+static Graph random_graph(std::size_t n, Rng& rng) {
+    test::EdgeList edges = test::erdos_renyi(n, 0.4, rng);
+    for (std::size_t v = 0; v < n; ++v) {
+        if (rng() % 3 == 0) edges.emplace_back(static_cast<Vertex>(v), static_cast<Vertex>(v));
+    }
+    return Graph(n, edges);
+}
+
+static int exact_size(const Graph& g1, const Graph& g2, int threads) {
+    McSplit exact(g1, g2);
+    exact.set_threads(threads);
+    const Mapping result = exact.solve();
+    CHECK(exact.is_optimal());
+    CHECK(feasible(g1, g2, result));
+    return result.size();
+}
+
+int main() {
+    // Lazo en a y en z: {a, b} → {x, y} es válido aunque a tenga lazo y x no
+    {
+        const Graph l1(2, {{0, 0}, {0, 1}});
+        const Graph l2(3, {{0, 1}, {2, 2}});
+        CHECK(exact_size(l1, l2, 1) == 2);
+        CHECK(exact_size(l2, l1, 1) == 2);
+    }
+
+    Rng rng(314);
+    for (int k = 0; k < RANDOM_PAIRS; ++k) {
+        const Graph g1 = random_graph(1 + rng() % MAX_N, rng);
+        const Graph g2 = random_graph(1 + rng() % MAX_N, rng);
+        Mapping mapping(g1.num_vertices(), g2.num_vertices());
+        const int expected = brute_force(g1, g2, mapping, 0, 0);
+        CHECK(exact_size(g1, g2, 1) == expected);
+        CHECK(exact_size(g1, g2, 3) == expected);
+    }
+
+    std::cout << "mcsplit_exact: ok\n";
+    return 0;
+}
@@ -0,0 +1,98 @@
+#include "../include/aco.hpp"
+#include "test_common.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+using namespace mcs;
+
+/**
+ * @brief Tras el calentamiento, ACO::step() no reserva memoria.
+ *
+ * Se reemplaza el operator new global por uno que cuenta; las primeras
+ * iteraciones pueden reservar (búferes de la búsqueda local, el equipo de
+ * OpenMP), las siguientes no. Sin telemetría ni instantáneas anytime: esas
+ * rutas reservan a propósito y son opcionales.
+ */
+
+static std::atomic<long> allocations{0};
+
+static void* counted_alloc(std::size_t bytes) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(bytes ? bytes : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t bytes) { return counted_alloc(bytes); }
+void* operator new[](std::size_t bytes) { return counted_alloc(bytes); }
+void* operator new(std::size_t bytes, const std::nothrow_t&) noexcept {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(bytes ? bytes : 1);
+}
+void* operator new[](std::size_t bytes, const std::nothrow_t&) noexcept {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(bytes ? bytes : 1);
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+static constexpr std::size_t N = 64;
+static constexpr int WARMUP_STEPS = 10;
+static constexpr int MEASURED_STEPS = 60;
+
+static void check_steps(const std::string& name, const Graph& g1, const Graph& g2,
+                        ACOParams params) {
+    params.verbose = false;
+    params.max_iterations = WARMUP_STEPS + MEASURED_STEPS;
+    ACO aco(g1, g2, params);
+    for (int i = 0; i < WARMUP_STEPS; ++i) aco.step();
+
+    const long before = allocations.load();
+    for (int i = 0; i < MEASURED_STEPS; ++i) aco.step();
+    const long during = allocations.load() - before;
+
+    if (during != 0) {
+        std::cerr << name << ": " << during << " reservas en " << MEASURED_STEPS
+                  << " iteraciones\n";
+    }
+    CHECK(during == 0);
+    CHECK(aco.get_convergence_history().size() ==
+          static_cast<std::size_t>(WARMUP_STEPS + MEASURED_STEPS));
+    std::cout << name << ": 0 reservas, mejor " << aco.get_best_score() << "\n";
+}
+
+int main() {
+    Rng rng(99);
+    const test::EdgeList edges = test::erdos_renyi(N, 0.2, rng);
+    test::EdgeList perturbed = test::permuted(edges, N, rng);
+    perturbed.resize(perturbed.size() * 9 / 10);
+    const Graph g1(N, edges);
+    const Graph g2(N, perturbed);
+
+    ACOParams params;
+    params.seed = 3;
+    params.num_ants = 12;
+    params.num_threads = 1;
+    check_steps("aco", g1, g2, params);
+
+    params.num_threads = 2;
+    check_steps("aco (2 hilos)", g1, g2, params);
+
+    params.mmas = true;
+    params.local_search = LocalSearchMode::Best;
+    check_steps("mmas+ls", g1, g2, params);
+
+    params.local_search = LocalSearchMode::All;
+    check_steps("ls en todas", g1, g2, params);
+
+    params.pheromone_storage = PheromoneStorage::Sparse;
+    params.local_search = LocalSearchMode::None;
+    params.mmas = false;
+    check_steps("feromonas dispersas", g1, g2, params);
+
+    std::cout << "step_allocations: ok\n";
+    return 0;
+}
@@ -0,0 +1,50 @@
+#include "../include/telemetry.hpp"
+#include "test_common.hpp"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+
+using namespace mcs;
+
+/**
+ * @brief Cada lote de telemetría llega al archivo sin esperar a close().
+ *
+ * Quien sigue el archivo (tail -f, un tablero) debe ver las iteraciones
+ * mientras el solver corre; se lee con otro ifstream con el escritor abierto.
+ */
+
+static std::string read_all(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+int main() {
+    const std::string path =
+        (std::filesystem::temp_directory_path() / "mcs_test_telemetry.ndjson").string();
+    std::filesystem::remove(path);
+
+    {
+        TelemetryWriter writer(path, TelemetryFormat::Ndjson);
+        IterationStats stats;
+        stats.iteration = 7;
+        stats.best_size = 12;
+        writer.push(stats);
+
+        // El hilo escritor vacía el lote poco después; margen amplio para CI lento
+        bool seen = false;
+        for (int attempt = 0; attempt < 500 && !seen; ++attempt) {
+            seen = read_all(path).find("\"iteracion\":7,\"mejor\":12") != std::string::npos;
+            if (!seen) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        CHECK(seen);
+        CHECK(writer.close());
+        CHECK(writer.dropped() == 0);
+    }
+
+    std::filesystem::remove(path);
+    std::cout << "telemetry_flush: ok\n";
+    return 0;
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include "../include/graph.hpp"
+#include "../include/rng.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Utilidades de las pruebas de regresión (meson test).
+ *
+ * Cada prueba es un ejecutable que regresa 0 si todo pasó; CHECK reporta la
+ * condición que falló y termina con 1. Las instancias se generan con
+ * semilla fija, igual que en mcs_bench.
+ */
+
+#define CHECK(cond)                                                          \
+    do {                                                                     \
+        if (!(cond)) {                                                       \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": falló " #cond "\n"; \
+            std::exit(1);                                                    \
+        }                                                                    \
+    } while (0)
+
+namespace mcs {
+namespace test {
+
+using EdgeList = std::vector<std::pair<Graph::Vertex, Graph::Vertex>>;
+
+inline EdgeList erdos_renyi(std::size_t n, double p, Rng& rng) {
+    const auto threshold = static_cast<std::uint64_t>(p * static_cast<double>(Rng::max()));
+    EdgeList edges;
+    for (std::size_t u = 0; u < n; ++u) {
+        for (std::size_t v = u + 1; v < n; ++v) {
+            if (rng() <= threshold) {
+                edges.emplace_back(static_cast<Graph::Vertex>(u), static_cast<Graph::Vertex>(v));
+            }
+        }
+    }
+    return edges;
+}
+
+/// Misma gráfica con los vértices permutados al azar.
+inline EdgeList permuted(const EdgeList& edges, std::size_t n, Rng& rng) {
+    std::vector<Graph::Vertex> perm(n);
+    std::iota(perm.begin(), perm.end(), 0);
+    for (std::size_t i = n; i > 1; --i) std::swap(perm[i - 1], perm[rng() % i]);
+    EdgeList out;
+    out.reserve(edges.size());
+    for (const auto& [u, v] : edges) out.emplace_back(perm[u], perm[v]);
+    return out;
+}
+
+} // namespace test
+} // namespace mcs
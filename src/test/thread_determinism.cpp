@@ -0,0 +1,81 @@
+#include "../include/mcs.hpp"
+#include "test_common.hpp"
+#include <string>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace mcs;
+
+/**
+ * @brief La solución no depende del número de hilos.
+ *
+ * Con la misma semilla, cada hormiga usa su propio flujo aleatorio
+ * (stream_seed), así que 1, 2 y 8 hilos deben dar exactamente el mismo
+ * mapeo, tamaño y aristas, en una colonia y en el modelo de islas.
+ */
+
+static constexpr std::size_t N = 48;
+
+static SolveResult run(const Graph& g1, const Graph& g2, SolveOptions options, int threads) {
+    options.aco.num_threads = threads;
+    return solve(g1, g2, options);
+}
+
+static void check_configuration(const std::string& name, const Graph& g1, const Graph& g2,
+                                const SolveOptions& options) {
+    const SolveResult reference = run(g1, g2, options, 1);
+    CHECK(reference.size > 0);
+    for (int threads : {2, 8}) {
+        const SolveResult result = run(g1, g2, options, threads);
+        if (result.mapping.pairs() != reference.mapping.pairs()) {
+            std::cerr << name << ": el mapeo cambia con " << threads << " hilos\n";
+        }
+        CHECK(result.mapping.pairs() == reference.mapping.pairs());
+        CHECK(result.size == reference.size);
+        CHECK(result.edges == reference.edges);
+        CHECK(result.iterations == reference.iterations);
+    }
+    std::cout << name << ": " << reference.size << " vértices, "
+              << reference.edges << " aristas\n";
+}
+
+int main() {
+    // Par con semilla fija: G₂ es G₁ permutada sin una de cada siete aristas,
+    // así que el MCIS no es trivial
+    Rng rng(2024);
+    const test::EdgeList edges = test::erdos_renyi(N, 0.3, rng);
+    test::EdgeList perturbed = test::permuted(edges, N, rng);
+    for (std::size_t i = perturbed.size(); i-- > 0;) {
+        if (i % 7 == 0) perturbed.erase(perturbed.begin() + static_cast<std::ptrdiff_t>(i));
+    }
+    const Graph g1(N, edges);
+    const Graph g2(N, perturbed);
+
+    SolveOptions options;
+    options.aco.seed = 11;
+    options.aco.num_ants = 10;
+    options.aco.max_iterations = 30;
+    check_configuration("aco", g1, g2, options);
+
+    options.aco.mmas = true;
+    options.aco.local_search = LocalSearchMode::Best;
+    check_configuration("mmas+ls", g1, g2, options);
+
+    options.use_islands = true;
+    options.islands.islands = 3;
+    options.islands.migration_interval = 10;
+#ifdef _OPENMP
+    // Las islas anidan equipos, pero no deben dejar cambiado el ajuste del proceso
+    omp_set_max_active_levels(1);
+    check_configuration("islas", g1, g2, options);
+    CHECK(omp_get_max_active_levels() == 1);
+#else
+    check_configuration("islas", g1, g2, options);
+#endif
+
+    std::cout << "thread_determinism: ok\n";
+    return 0;
+}